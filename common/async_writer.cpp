@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#include "headers/async_writer.hpp"
+#include "headers/file_utils.hpp"
+
+AsyncWriter::AsyncWriter(size_t capacity) : capacity(capacity) {}
+
+AsyncWriter::~AsyncWriter() {
+    flush();
+}
+
+bool AsyncWriter::submit(vector<char> &&buffer, const string &filepath,
+                         const string &info, bool overwrite) {
+    return enqueue({ filepath, std::move(buffer), false }, info, overwrite);
+}
+
+bool AsyncWriter::submit(const string &contents, const string &filepath,
+                         const string &info, bool overwrite) {
+    return enqueue({ filepath, vector<char>(contents.begin(), contents.end()), true }, info, overwrite);
+}
+
+bool AsyncWriter::enqueue(WriteJob &&job, const string &info, bool overwrite) {
+    job.filepath += compressionExt(compression);
+    if (job.buffer.empty() || !fHandleInfo(job.filepath, info, overwrite))
+        return false;
+
+    if (!jobs) {
+        jobs = make_unique<BoundedQueue<WriteJob>>(capacity);
+        worker = thread([this]() {
+            while (auto next = jobs->pop())
+                fWriteBuffer(next->filepath, next->buffer.data(), next->buffer.size(), next->text);
+        });
+    }
+    return jobs->push(std::move(job));
+}
+
+void AsyncWriter::flush() {
+    if (!jobs)
+        return;
+    jobs->close();  // the worker drains the queue, then exits
+    worker.join();
+    jobs.reset();
+}
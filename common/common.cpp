@@ -41,10 +41,10 @@ namespace MyCommon {
             resetConsoleColor();
     }
 
-#elif __APPLE__
+#else
 
     void resetConsoleColor() {
-        cout << "\033[0m"; // Reset on macOS (ANSI escape codes)
+        cout << "\033[0m"; // Reset on macOS & Linux (ANSI escape codes)
     }
 
     void formatTxt(const string &txt,
@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#include <algorithm>
+#include <filesystem>
+
+#ifdef MCCA_HAVE_ZLIB
+    #include <zlib.h>
+#endif
+#ifdef MCCA_HAVE_ZSTD
+    #include <zstd.h>
+#endif
+
+#include "headers/compressed_file.hpp"
+#include "headers/common.hpp"
+
+using namespace MyCommon;
+
+namespace {
+    bool hasSuffix(const string &str, const string &suffix) {
+        return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // zlib counts in 32-bit uInt - larger buffers are fed in pieces
+    constexpr size_t ZLIB_MAX_CHUNK = 1u << 30;
+}
+
+Compression fCompression(const string &filepath) {
+    if (hasSuffix(filepath, ".gz"))
+        return Compression::GZIP;
+    if (hasSuffix(filepath, ".zst"))
+        return Compression::ZSTD;
+    return Compression::NONE;
+}
+
+bool isCompressionSupported(Compression format) {
+    switch (format) {
+        case Compression::NONE:
+            return true;
+        case Compression::GZIP:
+#ifdef MCCA_HAVE_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case Compression::ZSTD:
+#ifdef MCCA_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+    }
+    return false;
+}
+
+string compressionExt(Compression format) {
+    switch (format) {
+        case Compression::GZIP: return ".gz";
+        case Compression::ZSTD: return ".zst";
+        default: return "";
+    }
+}
+
+struct DecompressReader::Codec {
+#ifdef MCCA_HAVE_ZLIB
+    z_stream zs{};
+    bool zInit = false;
+#endif
+#ifdef MCCA_HAVE_ZSTD
+    ZSTD_DStream *zds = nullptr;
+#endif
+
+    ~Codec() {
+#ifdef MCCA_HAVE_ZLIB
+        if (zInit)
+            inflateEnd(&zs);
+#endif
+#ifdef MCCA_HAVE_ZSTD
+        if (zds)
+            ZSTD_freeDStream(zds);
+#endif
+    }
+};
+
+DecompressReader::DecompressReader(const string &filepath, size_t chunkSize, bool report) :
+    filepath(filepath), format(fCompression(filepath)), report(report), file(filepath, ios::binary) {
+    if (!file.is_open())
+        return;
+    open = true;
+    if (format == Compression::NONE)
+        return;
+    if (!isCompressionSupported(format)) {
+        if (report)
+            handleError(ErrCode::COMPRESSION_NA, compressionExt(format));
+        error = true;
+        return;
+    }
+    in.resize(chunkSize);
+    codec = make_unique<Codec>();
+#ifdef MCCA_HAVE_ZLIB
+    if (format == Compression::GZIP) {
+        // 15 + 32: max window, gzip or zlib header detected automatically
+        if (inflateInit2(&codec->zs, 15 + 32) != Z_OK)
+            fail("inflateInit2 failed");
+        else
+            codec->zInit = true;
+    }
+#endif
+#ifdef MCCA_HAVE_ZSTD
+    if (format == Compression::ZSTD) {
+        codec->zds = ZSTD_createDStream();
+        if (!codec->zds || ZSTD_isError(ZSTD_initDStream(codec->zds)))
+            fail("ZSTD_initDStream failed");
+    }
+#endif
+}
+
+DecompressReader::~DecompressReader() = default;
+
+void DecompressReader::fail(const string &reason) {
+    if (report && !error)
+        handleError(ErrCode::INVALID_COMPRESSED, reason, filepath);
+    error = true;
+}
+
+bool DecompressReader::refill() {
+    file.read(in.data(), in.size());
+    inLen = static_cast<size_t>(file.gcount());
+    inPos = 0;
+    return inLen > 0;
+}
+
+size_t DecompressReader::read(char *dst, size_t size) {
+    if (!open || error || size == 0)
+        return 0;
+    if (format == Compression::NONE) {
+        file.read(dst, size);
+        return static_cast<size_t>(file.gcount());
+    }
+    size_t produced = 0;
+    while (produced == 0 && !error) {
+        if (inPos == inLen && !refill()) {
+            if (!frameEnd)
+                fail("unexpected end of data");
+            return 0;
+        }
+        produced = decode(dst, size);
+    }
+    return produced;
+}
+
+size_t DecompressReader::decode(char *dst, size_t size) {
+#ifdef MCCA_HAVE_ZLIB
+    if (format == Compression::GZIP) {
+        z_stream &zs = codec->zs;
+        if (frameEnd) {  // more input after a complete member: concatenated gzip members
+            inflateReset(&zs);
+            frameEnd = false;
+        }
+        zs.next_in = reinterpret_cast<Bytef *>(in.data() + inPos);
+        zs.avail_in = static_cast<uInt>(inLen - inPos);
+        zs.next_out = reinterpret_cast<Bytef *>(dst);
+        zs.avail_out = static_cast<uInt>(min(size, ZLIB_MAX_CHUNK));
+        const uInt avail = zs.avail_out;
+        const int ret = inflate(&zs, Z_NO_FLUSH);
+        inPos = inLen - zs.avail_in;
+        if (ret == Z_STREAM_END)
+            frameEnd = true;
+        else if (ret != Z_OK && ret != Z_BUF_ERROR)
+            fail(zs.msg ? zs.msg : "inflate failed");
+        return avail - zs.avail_out;
+    }
+#endif
+#ifdef MCCA_HAVE_ZSTD
+    if (format == Compression::ZSTD) {
+        ZSTD_inBuffer input = { in.data(), inLen, inPos };
+        ZSTD_outBuffer output = { dst, size, 0 };
+        const size_t ret = ZSTD_decompressStream(codec->zds, &output, &input);
+        inPos = input.pos;
+        if (ZSTD_isError(ret))
+            fail(ZSTD_getErrorName(ret));
+        else
+            frameEnd = ret == 0;  // a following frame is decoded by the same stream
+        return output.pos;
+    }
+#endif
+    (void)dst;
+    (void)size;
+    fail("unsupported compression");
+    return 0;
+}
+
+bool fDecompress(const string &filepath, vector<char> &out, bool report) {
+    DecompressReader reader(filepath, READ_CHUNK_SIZE, report);
+    if (!reader.isOpen())
+        return false;
+
+    // text matrices compress ~8x: start from a fair guess, then grow geometrically
+    error_code ec;
+    const auto fileSize = filesystem::file_size(filepath, ec);
+    out.resize(max<size_t>(READ_CHUNK_SIZE, ec ? 0 : 8 * static_cast<size_t>(fileSize)));
+    size_t len = 0;
+    for (;;) {
+        if (out.size() - len < READ_CHUNK_SIZE)
+            out.resize(2 * out.size());
+        const size_t n = reader.read(out.data() + len, out.size() - len);
+        if (n == 0)
+            break;
+        len += n;
+    }
+    out.resize(len);
+    return !reader.failed();
+}
+
+vector<char> fCompress(const char *data, size_t size, Compression format) {
+    vector<char> out;
+#ifdef MCCA_HAVE_ZLIB
+    if (format == Compression::GZIP) {
+        z_stream zs{};
+        // 15 + 16: max window, gzip wrapper
+        if (deflateInit2(&zs, GZIP_LEVEL, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+            return {};
+        out.resize(size / 4 + READ_CHUNK_SIZE);
+        size_t inPos = 0, outLen = 0;
+        int ret = Z_OK;
+        while (ret != Z_STREAM_END) {
+            if (out.size() - outLen < READ_CHUNK_SIZE)
+                out.resize(2 * out.size());
+            const size_t inChunk = min(size - inPos, ZLIB_MAX_CHUNK);
+            const size_t outChunk = min(out.size() - outLen, ZLIB_MAX_CHUNK);
+            zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(data + inPos));
+            zs.avail_in = static_cast<uInt>(inChunk);
+            zs.next_out = reinterpret_cast<Bytef *>(out.data() + outLen);
+            zs.avail_out = static_cast<uInt>(outChunk);
+            ret = deflate(&zs, inPos + inChunk == size ? Z_FINISH : Z_NO_FLUSH);
+            if (ret == Z_STREAM_ERROR) {
+                deflateEnd(&zs);
+                return {};
+            }
+            inPos += inChunk - zs.avail_in;
+            outLen += outChunk - zs.avail_out;
+        }
+        deflateEnd(&zs);
+        out.resize(outLen);
+        return out;
+    }
+#endif
+#ifdef MCCA_HAVE_ZSTD
+    if (format == Compression::ZSTD) {
+        out.resize(ZSTD_compressBound(size));
+        const size_t outLen = ZSTD_compress(out.data(), out.size(), data, size, ZSTD_LEVEL);
+        if (ZSTD_isError(outLen))
+            return {};
+        out.resize(outLen);
+        return out;
+    }
+#endif
+    (void)data;
+    (void)size;
+    (void)format;
+    return out;
+}
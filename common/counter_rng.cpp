@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#include "headers/counter_rng.hpp"
+
+void rndFillRow(uint64_t seed, int row, Cell *cells, int cols, int minValue, int maxValue) {
+    const uint64_t rowKey = splitMix64(seed ^ splitMix64(static_cast<uint64_t>(row)));
+    const uint32_t range = static_cast<uint32_t>(maxValue - minValue + 1);
+
+    auto cell = [&](uint64_t hash, int k) {
+        return static_cast<Cell>(minValue + ((((hash >> (16 * k)) & 0xFFFF) * range) >> 16));
+    };
+
+    const int blocks = cols / 4;
+    for (int b = 0; b < blocks; b++) {  // no loop-carried state: vectorizable
+        const uint64_t hash = splitMix64(rowKey + static_cast<uint64_t>(b));
+        for (int k = 0; k < 4; k++)
+            cells[4 * b + k] = cell(hash, k);
+    }
+    if (const int tail = cols - 4 * blocks; tail > 0) {
+        const uint64_t hash = splitMix64(rowKey + static_cast<uint64_t>(blocks));
+        for (int k = 0; k < tail; k++)
+            cells[4 * blocks + k] = cell(hash, k);
+    }
+}
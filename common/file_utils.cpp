@@ -19,6 +19,7 @@
 
 #include "headers/file_utils.hpp"
 #include "headers/common.hpp"
+#include "headers/compressed_file.hpp"
 
 
 // calc directory size except for file names specified by filenameFilter
@@ -83,14 +84,8 @@ void fWrite(const string &contents,
             bool overwrite) {
     if (contents.empty())
         return;
-    fHandleInfo(filepath, info, overwrite);
-    ofstream file(filepath);
-    if (!file.is_open()) {
-        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext());
-        return;
-    }
-    file << contents;
-    file.close();
+    if (fHandleInfo(filepath, info, overwrite))
+        fWriteBuffer(filepath, contents.data(), contents.size(), true);
 }
 
 //Write to file directly from buffer 
@@ -100,30 +95,52 @@ void fWrite(const vector <char> &buffer,
             bool overwrite) {
     if (buffer.empty())
         return;
-    fHandleInfo(filepath, info, overwrite);     
-    ofstream file(filepath, ios::binary);
-    if (!file.is_open()) {
-        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext());
-        return;
-    }
-    file.write(buffer.data(), buffer.size());
-    file.close();
+    if (fHandleInfo(filepath, info, overwrite))
+        fWriteBuffer(filepath, buffer.data(), buffer.size());
 }
 
-void fHandleInfo(const string &filepath,
+bool fHandleInfo(const string &filepath,
                  const string &info,
                  bool overwrite) {
-    ifstream infile(filepath);
-    bool fileExists = infile.good();
-    infile.close();
+    const bool fileExists = fExists(filepath);
     if ((!overwrite) && fileExists) {
         handleError(ErrCode::OVR_NOT_ENABLED, ErrorContext(filepath));
-        return;
+        return false;
     }
     ostringstream oss;
     const string actionPrefix = fileExists ? "Overwriting" : "Writing";
     oss << actionPrefix << " " << info << ": " << filepath;
     formatTxt(oss, LIGHT_GREEN);
+    return true;
+}
+
+bool fExists(const string &filepath) {
+    error_code ec;  // no exceptions, an unreadable path just doesn't exist
+    return filesystem::exists(filepath, ec);
+}
+
+bool fWriteBuffer(const string &filepath, const char *data, size_t size, bool text) {
+    vector<char> compressed;
+    if (const Compression format = fCompression(filepath); format != Compression::NONE) {
+        if (!isCompressionSupported(format)) {
+            handleError(ErrCode::COMPRESSION_NA, compressionExt(format));
+            return false;
+        }
+        compressed = fCompress(data, size, format);
+        if (compressed.empty())
+            return false;
+        data = compressed.data();
+        size = compressed.size();
+        text = false;
+    }
+    ofstream file(filepath, text ? ios::out : ios::out | ios::binary);
+    if (!file.is_open()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext(filepath));
+        return false;
+    }
+    file.write(data, static_cast<streamsize>(size));
+    file.close();
+    return !file.fail();
 }
 
 string fGenPath(const string &filename, 
@@ -135,6 +152,15 @@ string fGenPath(const string &filename,
     return full_filepath.str();
 }
 
+// extensions differ in length (txt/csv, mccb), so strip whatever follows the last '.' of the filename;
+// a compression suffix (.gz, .zst) goes along with the extension before it
 string fRemoveExt(const string &filename) {
-    return filename.substr(0, filename.length() - EXT_LEN - 1);
+    const Compression format = fCompression(filename);
+    if (format != Compression::NONE)
+        return fRemoveExt(filename.substr(0, filename.size() - compressionExt(format).size()));
+    const size_t dot = filename.find_last_of('.');
+    const size_t sep = filename.find_last_of("/\\");
+    if (dot == string::npos || (sep != string::npos && dot < sep))
+        return filename;
+    return filename.substr(0, dot);
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#include <cstring>
+
+#include "headers/grid.hpp"
+
+Grid::Grid() : base(nullptr), nRows(0), nCols(0), pad(0), rowStride(0) {}
+
+Grid::Grid(int rows, int cols, int border) :
+    cells(static_cast<size_t>(rows + 2 * border) * (cols + 2 * border), SENTINEL),
+    base(cells.data()), nRows(rows), nCols(cols), pad(border), rowStride(cols + 2 * border) {}
+
+Grid::Grid(int rows, int cols, vector<Cell> &&src, int border) :
+    cells(std::move(src)), base(cells.data()), nRows(rows), nCols(cols), pad(border),
+    rowStride(cols + 2 * border) {
+
+    if (border == 0)
+        return;
+
+    cells.resize(static_cast<size_t>(rows + 2 * border) * rowStride);
+    base = cells.data();
+
+    // Move rows into their padded slots, last row first (destinations never overlap unread sources)
+    for (int r = rows - 1; r >= 0; --r) {
+        Cell *dst = row(r);
+        memmove(dst, cells.data() + static_cast<size_t>(r) * cols, cols);
+        memset(dst - border, SENTINEL, border);
+        memset(dst + cols, SENTINEL, border);
+    }
+    memset(cells.data(), SENTINEL, border * rowStride);
+    memset(row(rows) - border, SENTINEL, border * rowStride);
+}
+
+Grid::Grid(Cell *base, int rows, int cols, int border, shared_ptr<void> storage) :
+    base(base), storage(std::move(storage)), nRows(rows), nCols(cols), pad(border),
+    rowStride(cols + 2 * border) {}
+
+Grid::Grid(const Grid &other) :
+    cells(other.base, other.base + other.paddedSize()), base(cells.data()),
+    nRows(other.nRows), nCols(other.nCols), pad(other.pad), rowStride(other.rowStride) {}
+
+Grid &Grid::operator=(const Grid &other) {
+    if (this != &other)
+        *this = Grid(other);
+    return *this;
+}
+
+// A moved vector keeps its buffer, so base stays valid for owned & external cells alike
+Grid::Grid(Grid &&other) noexcept :
+    cells(std::move(other.cells)), base(other.base), storage(std::move(other.storage)),
+    nRows(other.nRows), nCols(other.nCols), pad(other.pad), rowStride(other.rowStride) {
+    other.base = nullptr;
+    other.nRows = other.nCols = other.pad = 0;
+    other.rowStride = 0;
+}
+
+Grid &Grid::operator=(Grid &&other) noexcept {
+    if (this != &other) {
+        cells = std::move(other.cells);
+        base = other.base;
+        storage = std::move(other.storage);
+        nRows = other.nRows;
+        nCols = other.nCols;
+        pad = other.pad;
+        rowStride = other.rowStride;
+        other.base = nullptr;
+        other.nRows = other.nCols = other.pad = 0;
+        other.rowStride = 0;
+    }
+    return *this;
+}
+
+Grid Grid::withBorder(int border) const {
+    Grid padded(nRows, nCols, border);
+    for (int r = 0; r < nRows; ++r)
+        memcpy(padded.row(r), row(r), nCols);
+    return padded;
+}
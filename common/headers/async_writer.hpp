@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bounded_queue.hpp"
+#include "compressed_file.hpp"
+#include "constants.hpp"
+
+using namespace std;
+
+// Background file writer: takes ownership of finished buffers & writes them on its own thread,
+// in submission order, each through a single open/write/close. Submitting blocks while
+// capacity buffers are pending (backpressure). The announcement & the existence check run
+// on the caller's thread, so console output keeps its order.
+class AsyncWriter {
+public:
+    explicit AsyncWriter(size_t capacity = WRITE_QUEUE_DEPTH);
+    ~AsyncWriter();  // flushes
+
+    AsyncWriter(const AsyncWriter &) = delete;
+    AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+    // false if skipped (empty buffer, or the file exists & overwrite is disabled)
+    bool submit(vector<char> &&buffer, const string &filepath,
+                const string &info = DEFAULT_INFO, bool overwrite = EN_OVR);
+
+    // Text contents (line endings translated where the platform does)
+    bool submit(const string &contents, const string &filepath,
+                const string &info = DEFAULT_INFO, bool overwrite = EN_OVR);
+
+    // Block until every submitted buffer is written (the worker is restarted on demand)
+    void flush();
+
+    // Appended to each filepath (its suffix, e.g. .gz); the worker compresses the buffers
+    Compression compression = Compression::NONE;
+
+private:
+    struct WriteJob {
+        string filepath;
+        vector<char> buffer;
+        bool text;
+    };
+
+    const size_t capacity;
+    unique_ptr<BoundedQueue<WriteJob>> jobs;
+    thread worker;
+
+    bool enqueue(WriteJob &&job, const string &info, bool overwrite);
+};
@@ -19,6 +19,8 @@
 
 #pragma once
 
+#include <cstdint>
+
  // Define color constants for both platforms
 #ifdef _WIN32
     // Windows color codes (based on standard 16-color palette)
@@ -76,6 +78,26 @@ inline unsigned short getColorFromKey(int key) {
     }
 }
 
+// Utility function to return the RGB color of a key (for raster images), close to its console color
+inline void getRgbFromKey(int key, uint8_t *rgb) {
+    static constexpr uint8_t palette[][3] = {
+        { 255, 255, 255 },  // default: white
+        {  80, 120, 255 },  // 1: light blue
+        {  80, 230,  80 },  // 2: light green
+        { 255, 240,  80 },  // 3: light yellow
+        { 190,  50, 190 },  // 4: magenta
+        { 255,  80,  80 },  // 5: light red
+        {  80, 240, 240 },  // 6: light cyan
+        {  20, 150,  20 },  // 7: green
+        { 160, 160, 160 },  // 8: light grey
+        { 255, 150, 190 },  // 9: pink
+    };
+    const auto &color = palette[(key >= 1 && key <= 9) ? key : 0];
+    rgb[0] = color[0];
+    rgb[1] = color[1];
+    rgb[2] = color[2];
+}
+
 // Utility function to map a color key to a symbol
 inline char getSymbolFromKey(int key) {
     switch (key) {
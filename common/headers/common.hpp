@@ -36,9 +36,9 @@ namespace MyCommon {
     #include <Windows.h>
     extern HANDLE handle;
 
-#elif __APPLE__
+#else
 
-    #include <unistd.h>  // For POSIX signal handling on macOS
+    #include <unistd.h>  // For POSIX signal handling on macOS & Linux
 
 #endif
     
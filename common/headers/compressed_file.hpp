@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+
+using namespace std;
+
+// Compressed matrix & result files, told apart by their last extension (.gz, .zst).
+// gzip needs zlib (MCCA_HAVE_ZLIB), zstd needs libzstd (MCCA_HAVE_ZSTD) - both optional at build time.
+enum class Compression { NONE, GZIP, ZSTD };
+
+Compression fCompression(const string &filepath);
+
+bool isCompressionSupported(Compression format);
+
+// ".gz" / ".zst", empty for NONE
+string compressionExt(Compression format);
+
+// Streaming reader of a (possibly) compressed file: read() yields the decompressed bytes chunk by
+// chunk, in O(chunk) memory. Uncompressed files are read as is. Corrupt or truncated data sets
+// failed(), reported (INVALID_COMPRESSED) only if report is set.
+class DecompressReader {
+public:
+    explicit DecompressReader(const string &filepath, size_t chunkSize = READ_CHUNK_SIZE, bool report = true);
+    ~DecompressReader();
+
+    DecompressReader(const DecompressReader &) = delete;
+    DecompressReader &operator=(const DecompressReader &) = delete;
+
+    bool isOpen() const { return open; }
+
+    // Up to size decompressed bytes into dst, 0 at EOF or on error (see failed)
+    size_t read(char *dst, size_t size);
+
+    bool failed() const { return error; }
+
+private:
+    struct Codec;  // library stream state
+
+    const string filepath;
+    const Compression format;
+    const bool report;
+    ifstream file;
+    unique_ptr<Codec> codec;
+    vector<char> in;
+    size_t inPos = 0, inLen = 0;
+    bool open = false;
+    bool frameEnd = false;  // the last compressed frame/member is complete
+    bool error = false;
+
+    bool refill();
+    size_t decode(char *dst, size_t size);
+    void fail(const string &reason);
+};
+
+// Whole file, decompressed into out - false on any error, reported only if report is set
+bool fDecompress(const string &filepath, vector<char> &out, bool report = true);
+
+// data compressed as a single gzip member / zstd frame, empty on failure
+vector<char> fCompress(const char *data, size_t size, Compression format);
@@ -19,6 +19,9 @@
 
 #pragma once
 
+#include <climits>
+#include <cstddef>
+
 // title & version
 inline constexpr char COPYRIGHT[] = "\nCopyright (C) Yaron Dayan 2025\n";
 inline constexpr char VERSION[] = "v2.3.2";
@@ -31,6 +34,11 @@ inline constexpr char DEFAULT_INFO[] = "file";
 // visualizer config
 inline constexpr int VIS_MAT_THR = 50;
 inline constexpr char VIS_IMAGE_FORMATS[] = "svg, svgz, png, jpeg, jpg, gif, tif, tiff, bmp, fig, json, pdf";
+inline constexpr char VIS_MODES[] = "tree, condensed";  // tree is limited to VIS_MAT_THR
+inline constexpr char DEFAULT_VIS_MODE[] = "tree";
+inline constexpr double VIS_NODE_MIN_WIDTH = 0.2;       // condensed node diameter range (inches)
+inline constexpr double VIS_NODE_MAX_WIDTH = 2.0;
+inline constexpr size_t VIS_DOT_CHUNK_BYTES = 4 << 20;  // dot text buffered before each write
 
 // io 
 inline constexpr char DEFAULT_ROOTDIR[] = "../data/multicolor";
@@ -38,7 +46,21 @@ inline constexpr bool EN_TXT = true;
 inline constexpr bool EN_OVR = false;
 inline constexpr bool EN_CONFIRM = false;
 inline constexpr int TABWIDTH = 4;
-inline constexpr int EXT_LEN = 3; // default file extension length
+inline constexpr size_t READ_CHUNK_SIZE = 1 << 20;  // chunked matrix file reader (bytes)
+inline constexpr size_t WRITE_QUEUE_DEPTH = 4;      // result buffers pending on the background writer
+inline constexpr size_t GEN_CHUNK_BYTES = 4 << 20;  // filegen: rows buffered per file before each write
+inline constexpr size_t TERM_FRAME_BYTES = 4 << 20; // --paint: max rendered text held before writing it
+
+// .mccb binary matrix files: fixed little-endian header, then raw (bordered) or nibble-packed cells
+inline constexpr char MCCB_MAGIC[] = "MCCB";
+inline constexpr int MCCB_VERSION = 1;
+inline constexpr size_t MCCB_HEADER_SIZE = 64;
+inline constexpr char CONVERT_FORMATS[] = "txt, csv, mccb";
+
+// Compressed txt/csv files (.gz via zlib, .zst via libzstd - optional at build time)
+inline constexpr char COMPRESS_FORMATS[] = "gz, zst";
+inline constexpr int GZIP_LEVEL = 6;
+inline constexpr int ZSTD_LEVEL = 3;
 
 // mat_files defaults
 inline constexpr int DEFAULT_MIN_R = 200;
@@ -47,6 +69,7 @@ inline constexpr int DEFAULT_INC = 50;
 inline constexpr int DEFAULT_MIN_V = 1;
 inline constexpr int DEFAULT_MAX_V = 3;
 inline constexpr bool DEFAULT_SQMAT = true;
+inline constexpr int SEED_MAX = INT_MAX;  // filegen --seed
 
 // File generator defaults; same init values for cols
 inline constexpr int ROWS_MIN = 1;       
@@ -58,6 +81,40 @@ inline constexpr int MAX_VAL = 9;
 inline constexpr double MAX_FILE_SIZE_MB = 500.0;
 inline constexpr bool DEFAULT_FILEGEN = false;
 
+// Grid: sentinel border width around each matrix (lets the engines skip bounds checks)
+inline constexpr int GRID_BORDER = 1;
+
 // Algo
 inline constexpr bool IS_ALGO_SPECIFIED = false;
-inline constexpr bool SKIP_ALGO_HANDLER = false;
\ No newline at end of file
+inline constexpr bool SKIP_ALGO_HANDLER = false;
+
+// UnionFind find/union policies: COMPRESS (path compression), HALVING (path halving),
+// SPLITTING (path splitting) - all with union by size; REM (Rem's interleaved union);
+// LOCKFREE (concurrent CAS-linking union-find shared by all threads)
+inline constexpr char UF_POLICIES[] = "COMPRESS, HALVING, SPLITTING, REM, LOCKFREE";
+inline constexpr char DEFAULT_UF_POLICY[] = "HALVING";
+
+// Parallel labeling (--threads)
+inline constexpr int DEFAULT_THREADS = 1;
+inline constexpr int THREADS_MAX = 256;
+
+// Pipelined directory processing: max parsed matrices waiting for the solver (--queue_depth)
+inline constexpr int DEFAULT_QUEUE_DEPTH = 2;
+inline constexpr int QUEUE_DEPTH_MAX = 64;
+
+// Raster image export (--image): rendered & written in bands of about IMAGE_BAND_BYTES;
+// cells outside the max regions are dimmed to IMAGE_DIM_LEVEL / 256 of their color
+inline constexpr char IMAGE_FORMATS[] = "ppm, png";
+inline constexpr size_t IMAGE_BAND_BYTES = 16 << 20;
+inline constexpr int IMAGE_DIM_LEVEL = 96;
+
+// Result file formats (--result_format): dense (full n x m text grid) or a sparse encoding (see sparse_result.hpp)
+inline constexpr char RESULT_FORMATS[] = "dense, runs, coords, mask";
+inline constexpr char DEFAULT_RESULT_FORMAT[] = "dense";
+inline constexpr char MCCM_MAGIC[] = "MCCM";  // 1-bit mask result files (.mccm)
+inline constexpr int MCCM_VERSION = 1;
+inline constexpr size_t MCCM_HEADER_SIZE = 32;
+
+// Region table dump formats (--regions)
+inline constexpr char REGIONS_FORMATS[] = "csv, json";
+inline constexpr int SHARED_ROW_CHUNK = 16;  // rows per work item for the LOCKFREE UF policy
\ No newline at end of file
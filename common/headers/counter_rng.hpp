@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "grid.hpp"
+
+// SplitMix64 finalizer - a bijective 64-bit mix
+inline uint64_t splitMix64(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ULL;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+    return x ^ (x >> 31);
+}
+
+// Counter-based random cells: cell (row, col) depends on (seed, row, col) only, never on the order
+// (or the thread) the cells are drawn in. Each hash of (seed, row, col / 4) yields 4 cells of 16 bits,
+// mapped into [minValue, maxValue] by a multiply-shift.
+void rndFillRow(uint64_t seed, int row, Cell *cells, int cols, int minValue, int maxValue);
@@ -33,6 +33,11 @@ static const string withinRange(const int &minv, const int &maxv);
 enum class ErrCode {
     // CLI related
     INVALID_ALGO_SELECTION,
+    INVALID_UF_POLICY,
+    INVALID_REGIONS_FORMAT,
+    INVALID_IMAGE_FORMAT,
+    INVALID_RESULT_FORMAT,
+    INVALID_COMPRESS_FORMAT,
     MISSING_ARG_VALUE,
     INT_EXPECTED,
     UNKNOWN_OPTION,
@@ -55,6 +60,9 @@ enum class ErrCode {
     INVALID_DIR,
     CDIR_FAILURE,
     INVALID_FILE_EXT,
+    INVALID_MCCB,
+    INVALID_COMPRESSED,
+    COMPRESSION_NA,
     EMPTY_DIR,
     OVR_NOT_ENABLED,
     FILESIZE_LIMIT_REACHED,
@@ -63,6 +71,7 @@ enum class ErrCode {
     GRAPHVIZ_NA,
     GRAPHVIZ_MAT_LIMIT,
     GRAPHVIZ_IMG_FORMAT_ERR,
+    INVALID_VIS_MODE,
 
     GENERIC_EXCEPTION
 };
@@ -123,7 +132,10 @@ inline string getErrMsg(ErrCode code, const ErrorContext &context) {
     ostringstream oss;
 
     const string OVR_NA_ERR = "Overwrite must be enabled in order to carry out this action";
-    const string INVALID_FEXT_ERR = "Invalid file extension. Only 'txt' and 'csv' are supported";
+    const string INVALID_FEXT_ERR = "Invalid file extension. Only 'txt', 'csv' and 'mccb' are supported (txt/csv optionally compressed)";
+    const string INVALID_MCCB_ERR = "Invalid mccb file";
+    const string INVALID_COMPRESSED_ERR = "Corrupt compressed file";
+    const string COMPRESSION_NA_ERR = "This build has no support for compressed files of type";
     const string EMPTYDIR_ERR = "No matching files were found in directory.";
     const string ROWLEN_ERR = "Row length mismatch"; 
     const string MULTIDIGIT_ERR = "Multidigit detected"; 
@@ -176,7 +188,27 @@ inline string getErrMsg(ErrCode code, const ErrorContext &context) {
             break;
     
         case ErrCode::INVALID_ALGO_SELECTION:
-            oss << "Error: Invalid value for --algo option. Must be 'DFS', 'UF', or 'BOTH'!\n";
+            oss << "Error: Invalid value for --algo option. Must be 'DFS', 'UF', 'CCL', 'RUN' or 'BOTH'!\n";
+            break;
+    
+        case ErrCode::INVALID_UF_POLICY:
+            oss << "Error: Invalid value for --uf_policy option. Must be one of: " << UF_POLICIES << "!\n";
+            break;
+
+        case ErrCode::INVALID_REGIONS_FORMAT:
+            oss << "Error: Invalid value for --regions option. Must be one of: " << REGIONS_FORMATS << "!\n";
+            break;
+    
+        case ErrCode::INVALID_IMAGE_FORMAT:
+            oss << "Error: Invalid value for --image option. Must be one of: " << IMAGE_FORMATS << "!\n";
+            break;
+
+        case ErrCode::INVALID_RESULT_FORMAT:
+            oss << "Error: Invalid value for --result_format option. Must be one of: " << RESULT_FORMATS << "!\n";
+            break;
+
+        case ErrCode::INVALID_COMPRESS_FORMAT:
+            oss << "Error: Invalid value for --compress option. Must be one of: " << COMPRESS_FORMATS << "!\n";
             break;
     
         case ErrCode::MULTIDIGIT:
@@ -255,6 +287,10 @@ inline string getErrMsg(ErrCode code, const ErrorContext &context) {
             oss << GRAPHVIZ_MAT_LIMIT_ERR << VIS_MAT_THR << "!\n";
             break;
 
+        case ErrCode::INVALID_VIS_MODE:
+            oss << "Error: Invalid value for --vis_mode option. Must be one of: " << VIS_MODES << "!\n";
+            break;
+
         case ErrCode::GRAPHVIZ_IMG_FORMAT_ERR:
             oss << GRAPHVIZ_IMG_FORMAT_ERR;
             if (context.invalidStr && context.argName) {
@@ -305,6 +341,31 @@ inline string getErrMsg(ErrCode code, const ErrorContext &context) {
             oss << "!\n";
             break;
 
+        case ErrCode::INVALID_MCCB:
+            oss << INVALID_MCCB_ERR;
+            if (context.argName)
+                oss << " '" << *context.argName << "'";
+            if (context.invalidStr)
+                oss << ": " << *context.invalidStr;
+            oss << "!\n";
+            break;
+
+        case ErrCode::INVALID_COMPRESSED:
+            oss << INVALID_COMPRESSED_ERR;
+            if (context.argName)
+                oss << " '" << *context.argName << "'";
+            if (context.invalidStr)
+                oss << ": " << *context.invalidStr;
+            oss << "!\n";
+            break;
+
+        case ErrCode::COMPRESSION_NA:
+            oss << COMPRESSION_NA_ERR;
+            if (context.argName)
+                oss << " '" << *context.argName << "'";
+            oss << "!\n";
+            break;
+
         case ErrCode::OVR_NOT_ENABLED:
             if (context.argName)
                 oss << "File: " << *context.argName << "\n";        
@@ -21,6 +21,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <vector>
 #include "common.hpp"
 
 using namespace std;
@@ -57,6 +58,14 @@ void fWrite(const vector <char> &buffer,
 	        const string &info = DEFAULT_INFO,
 	        bool overwrite = EN_OVR);
 
-void fHandleInfo(const string &filepath,
+// Announce the write - false (reported) if the file exists & overwrite is disabled
+bool fHandleInfo(const string &filepath,
 	             const string &info = DEFAULT_INFO,
 				 bool overwrite = EN_OVR);
+
+// Existence check through a single status query (stat), no file opening
+bool fExists(const string &filepath);
+
+// Single open/write/close; text mode translates line endings where the platform does.
+// A .gz/.zst filepath gets the data compressed first (binary, see fCompress).
+bool fWriteBuffer(const string &filepath, const char *data, size_t size, bool text = false);
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once 
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "constants.hpp"
+
+using namespace std;
+
+// Matrix values are restricted to [MIN_VAL, MAX_VAL], so a single byte per cell suffices
+using Cell = uint8_t;
+
+// Value stored in the sentinel border, never equal to a valid cell value
+inline constexpr Cell SENTINEL = 0;
+
+// Contiguous, row-major matrix (1 byte per cell), surrounded by an optional sentinel border.
+// With border >= 1, the 8 neighbors of every cell are addressable without bounds checks.
+// Cells are either owned or external (e.g. a mapped .mccb payload, kept alive by storage).
+class Grid {
+public:
+    Grid();
+
+    Grid(int rows, int cols, int border = GRID_BORDER);
+
+    // Adopt tightly packed row-major cells (rows * cols), padding them in place
+    Grid(int rows, int cols, vector<Cell> &&cells, int border = GRID_BORDER);
+
+    // Use external cells, already laid out as (rows + 2 * border) x (cols + 2 * border)
+    Grid(Cell *base, int rows, int cols, int border, shared_ptr<void> storage);
+
+    // Copies always own their cells
+    Grid(const Grid &other);
+    Grid &operator=(const Grid &other);
+
+    // Moved-from grids are left empty (0 x 0)
+    Grid(Grid &&other) noexcept;
+    Grid &operator=(Grid &&other) noexcept;
+
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+    int border() const { return pad; }
+    size_t stride() const { return rowStride; }
+    size_t size() const { return static_cast<size_t>(nRows) * nCols; }
+    bool empty() const { return nRows == 0 || nCols == 0; }
+
+    // r, c may reach into the border: [-border, rows + border)
+    Cell &operator()(int r, int c) { return base[offset(r, c)]; }
+    Cell operator()(int r, int c) const { return base[offset(r, c)]; }
+
+    // Pointer to the first (non-border) cell of row r
+    Cell *row(int r) { return base + offset(r, 0); }
+    const Cell *row(int r) const { return base + offset(r, 0); }
+
+    // Whole padded storage (border included): (rows + 2 * border) * stride() cells
+    const Cell *data() const { return base; }
+    size_t paddedSize() const { return static_cast<size_t>(nRows + 2 * pad) * rowStride; }
+
+    // Copy with a different border width (sentinel filled)
+    Grid withBorder(int border) const;
+
+private:
+    vector<Cell> cells;
+    Cell *base;
+    shared_ptr<void> storage;
+    int nRows;
+    int nCols;
+    int pad;
+    size_t rowStride;
+
+    size_t offset(int r, int c) const {
+        return static_cast<size_t>(r + pad) * rowStride + (c + pad);
+    }
+};
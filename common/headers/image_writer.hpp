@@ -0,0 +1,69 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+
+using namespace std;
+
+// Raster images of a solved matrix (--image), written without any external encoder.
+// ppm: binary PPM (P6). png: RGB8, non-interlaced, its zlib stream made of stored (uncompressed)
+// deflate blocks, so encoding is a copy plus the CRC32 & Adler32 checksums.
+enum class ImageFormat { PPM, PNG };
+
+// Streaming RGB8 image writer: rows are appended top to bottom, in bands of any height;
+// only the current band is buffered. Open or write failures are reported (FILE_OPEN_ERROR) once.
+class ImageWriter {
+public:
+    ImageWriter(const string &filepath, int width, int height, ImageFormat format);
+    ~ImageWriter();  // finishes the image
+
+    ImageWriter(const ImageWriter &) = delete;
+    ImageWriter &operator=(const ImageWriter &) = delete;
+
+    // Append rows of width * 3 bytes each
+    void writeRows(const uint8_t *rgb, int rows);
+
+    // Write the trailer (after the last row), returns whether the whole image was written
+    bool finish();
+
+    bool failed() const { return fail; }
+
+private:
+    ofstream file;
+    string filepath;
+    int width, height;
+    ImageFormat format;
+    int rowsWritten = 0;
+    bool fail = false, finished = false;
+    uint32_t adler = 1;       // PNG: Adler32 of the zlib stream's raw data
+    vector<uint8_t> payload;  // PNG: IDAT chunk under construction
+
+    void writeChunk(const char type[4], const uint8_t *data, size_t size);
+    void checkStream();
+};
+
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t size);
+
+uint32_t adler32Update(uint32_t adler, const uint8_t *data, size_t size);
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+using namespace std;
+
+// Memory mapping of a whole file (POSIX mmap / Windows MapViewOfFile).
+// Read-only by default; a copy-on-write mapping is writable, its writes never reach the file.
+// isOpen() is false if the file can't be opened or mapped (e.g. an empty file).
+class MappedFile {
+public:
+    explicit MappedFile(const string &filepath, bool copyOnWrite = false);
+    ~MappedFile();
+
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool isOpen() const { return addr != nullptr; }
+
+    const char *data() const { return static_cast<const char *>(addr); }
+    // Copy-on-write mappings only
+    char *writableData() const { return static_cast<char *>(addr); }
+    size_t size() const { return length; }
+
+private:
+    void *addr = nullptr;
+    size_t length = 0;
+};
@@ -0,0 +1,31 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include "grid.hpp"
+
+// Vectorized matrix text parser (AVX2 / SSE2, portable scalar classification elsewhere).
+// Validates 64 bytes per step (digits 1-9, delimiters " ,;\t", CR/LF), rejects multi-digit runs
+// and row-length mismatches from the byte masks, then decodes the digits straight into the Grid.
+// Returns false - leaving matrix untouched - on any anomaly, so that the scalar parser can report
+// the exact error (INVALID_CHAR, INVALID_RANGE, MULTIDIGIT, ROW_LEN_MISMATCH) and its position.
+bool parseMatSimd(const char *data, size_t size, Grid &matrix);
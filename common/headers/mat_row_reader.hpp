@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "compressed_file.hpp"
+#include "grid.hpp"
+
+using namespace std;
+
+// Chunked, validating reader of a matrix text file - one row at a time, in O(row) memory.
+// Rows are separated by any run of CR/LF chars; rows without cells are skipped.
+// Errors (reported via handleError) carry the same row/col positions as a whole-file parse.
+// .gz/.zst files are decompressed on the fly, a chunk at a time (see DecompressReader).
+class MatRowReader {
+public:
+    explicit MatRowReader(const string &filepath, size_t chunkSize = READ_CHUNK_SIZE);
+
+    bool isOpen() const { return source.isOpen(); }
+
+    // Parse the next row into row, false at EOF or on error (see failed)
+    bool nextRow(vector<Cell> &row);
+
+    bool failed() const { return error || source.failed(); }
+
+    int rows() const { return numOfRows; }
+    int cols() const { return static_cast<int>(rowLen); }
+
+    // Parse the cells of a single row (no EOL chars) of file row rowCnt
+    static bool parseRow(const char *begin, const char *end, int rowCnt, vector<Cell> &row);
+
+private:
+    DecompressReader source;
+    vector<char> chunk;
+    size_t pos = 0, len = 0;
+    vector<char> line;  // current row bytes
+    int rowCnt = 0;     // file row (LF count) of the current row
+    int numOfRows = 0;
+    size_t rowLen = 0;
+    bool error = false;
+
+    bool fetch();
+
+    // Skip EOL chars, then gather the next row's bytes into line - false at EOF
+    bool readLine();
+};
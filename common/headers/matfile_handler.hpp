@@ -21,6 +21,17 @@
 
 #include "helpers.hpp"
 #include "file_utils.hpp"
+#include "grid.hpp"
+#include "mat_row_reader.hpp"
+#include "mapped_file.hpp"
+#include "mat_parser_simd.hpp"
+#include "mccb_file.hpp"
+#include "async_writer.hpp"
+#include "row_serializer.hpp"
+#include "counter_rng.hpp"
+
+#include <atomic>
+#include <thread>
 
 class MatFileHandler {
 
@@ -35,13 +46,20 @@ public:
     int min_v;
     int max_v;
     bool sqmat; 
+    optional<uint64_t> seed;    // reproducible random matrices (--seed), otherwise drawn per file
+    int threads;                // random matrix rows are drawn in parallel
 
     string destpath;
     bool confirm;
     bool txt;
     bool overwrite;
+    bool mccb;                  // write .mccb files (filegen, --matrix) instead of txt/csv
+    MccbEncoding mccbEncoding;
+    Compression compression;    // txt/csv files written compressed (filegen, convert, results)
 
-    vector<vector<int>> currMat;
+    Grid currMat;
+
+    AsyncWriter writer;  // result files, written behind the solver
 
     int parsedMatIdx;  // for matString
 
@@ -67,42 +85,62 @@ public:
     
     string updateStrByIntVect(vector<int>) const;
 
-    void displayMat(const vector<vector<int>> &mat);
+    void displayMat(const Grid &mat);
 
-    void displayMatrices(const vector<vector<vector<int>>> &mat_vector);
+    void displayMatrices(const vector<Grid> &mat_vector);
 
     bool isValidMatSpec(int rows, int cols) const;
 
-    vector<vector<int>> genRndMat(int rows, int cols, mt19937 gen);
+    // Seed of the rows x cols random matrix: derived from --seed (& the size), random otherwise
+    uint64_t rndMatSeed(int rows, int cols) const;
 
-    vector<vector<int>> genRndMatWrapper(int rows, int cols, 
-                                         optional<unsigned int> seed = nullopt);
+    // Counter-based (see rndFillRow): the matrix depends on the seed only, not on rowThreads
+    Grid genRndMat(int rows, int cols, uint64_t matSeed, int rowThreads = 1) const;
 
-    vector<vector<int>> parseMat(const string &matrixStr);
+    Grid parseMat(const string &matrixStr);
 
-    vector<vector<vector<int>>> parseMatrices(const string &matricesStr);
+    vector<Grid> parseMatrices(const string &matricesStr);
 
     void calcSizeSqMatFiles() const;
     
     void calcSizeMatFiles () const;
 
-    bool matLoader(vector<vector<int>> &matrix, const string &filepath);
+    bool matLoader(Grid &matrix, const string &filepath);
+
+    // Vectorized path (or a valid .mccb file) only - false, without reporting, if the file needs
+    // the reporting fallback. Touches no member state, so it may run on a loader thread.
+    bool matLoaderQuiet(Grid &matrix, const string &filepath) const;
+
+    // Reporting loader for the files matLoaderQuiet rejects (.mccb errors, scalar text parser)
+    bool matLoaderFallback(Grid &matrix, const string &filepath);
+
+    // Chunked row-by-row parser (no mapping, no SIMD)
+    bool matLoaderScalar(Grid &matrix, const string &filepath);
 
-    vector<pair<string, vector<vector<int>>>> fLoadMatrices();
+    // txt/csv files may be compressed (.gz, .zst - if supported by the build).
+    // A .mccb file shadows the txt/csv file of the same name
+    vector<string> listMatFiles() const;
 
-    void fWriteRndMat(int rows, int cols);
+    // Convert the matrix files under destpath to format (txt, csv or mccb), next to their sources
+    void convertMatFiles(const string &format);
+
+    // Unannounced write of a random matrix file. Text files are streamed GEN_CHUNK_BYTES worth of rows
+    // at a time; .mccb & compressed files are written from a whole buffer.
+    bool writeRndMat(const string &filepath, int rows, int cols, uint64_t matSeed, int rowThreads) const;
     
-    //write matrix -> buffer -> file
+    //write matrix -> buffer -> file (.mccb if the path has that extension)
     void fWriteMat(const string &filename = "mat_check", bool skipUpdate = false);
 
     vector<char> fillBuffMat();
 
-    vector <char> fillBuffRndMat(int rows, int cols, mt19937 gen);
+    // Same matrix as genRndMat, serialized straight into the text buffer
+    vector<char> fillBuffRndMat(int rows, int cols, uint64_t matSeed, int rowThreads = 1) const;
 
-    vector<char> fillBuffRndMat(int rows, int cols);
+    // Serialize rows [firstRow, lastRow) of that matrix into out (2 * cols + 1 bytes per row)
+    void fillRndRows(char *out, int firstRow, int lastRow, int cols, uint64_t matSeed, int rowThreads) const;
 
     // Helper function to initialize a buffer
-    vector<char> bufferInit(int min_r, int max_r, int min_c, int max_c);
+    vector<char> bufferInit(int min_r, int max_r, int min_c, int max_c) const;
 
     template <typename ConditionFunc, typename ValueFunc>
     vector<char> fillBuffer(ConditionFunc cellCondition,
@@ -124,6 +162,21 @@ public:
         return buffer;
     }
 
+    // Bulk variant for whole rows: rowCells(r, mask) returns row r's cells & may clear mask[c]
+    // (preset to 1) to blank cell c. Each row is serialized at once (see serializeRow).
+    template <typename RowFunc>
+    vector<char> fillBufferRows(RowFunc rowCells, int rows, int cols) {
+        auto buffer = bufferInit(0, rows - 1, 0, cols - 1);
+        const char delimiter = txt ? ' ' : ',';
+        vector<uint8_t> mask(cols, 1);
+        char *wPtr = buffer.data();
+        for (int r = 0; r < rows; ++r) {
+            const Cell *cells = rowCells(r, mask.data());
+            wPtr = serializeRow(cells, mask.data(), cols, delimiter, wPtr);
+        }
+        return buffer;
+    }
+
     // General-purpose buffer population function
     template <typename ValueFunc>
     void populateBuffer(vector<char> &buffer,
@@ -145,6 +198,26 @@ public:
         }
     }
 
+    // Split [0, rows) into one strip per worker thread, running func(firstRow, lastRow) on each (last excluded)
+    template <typename StripFunc>
+    static void forRowStrips(int rows, int workerThreads, StripFunc func) {
+        const int numOfStrips = max(1, min(workerThreads, rows));
+        auto stripRow = [&](int strip) {
+            return static_cast<int>(static_cast<long long>(rows) * strip / numOfStrips);
+        };
+        vector<thread> workers;
+        workers.reserve(numOfStrips - 1);
+        for (int strip = 1; strip < numOfStrips; strip++)
+            workers.emplace_back([&, strip]() { func(stripRow(strip), stripRow(strip + 1)); });
+        func(stripRow(0), stripRow(1));
+        for (auto &worker : workers)
+            worker.join();
+    }
+
+    // Generate a random matrix file per (rows, cols) pair: the files are announced in order,
+    // then written concurrently, by up to threads workers
+    void genRndMatFiles(const vector<pair<int, int>> &sizes);
+
     //Generate N x M matrix files
     void genMatFiles();
 
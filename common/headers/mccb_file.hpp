@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "grid.hpp"
+#include "mapped_file.hpp"
+
+using namespace std;
+
+// .mccb binary matrix file: a fixed 64-byte little-endian header, followed by the payload
+//   0 magic "MCCB" | 4 version (u16) | 6 encoding (u8) | 7 border (u8) | 8 rows (u32) | 12 cols (u32)
+//  16 min value (u8) | 17 max value (u8) | 24 payload size (u64) | 32 payload checksum (u64)
+//  other bytes are reserved (zero)
+enum class MccbEncoding : uint8_t {
+    RAW8 = 0,     // the Grid storage itself, sentinel border included - mapped & used in place
+    PACKED4 = 1   // two cells per byte (low nibble first), each row starts on a byte boundary
+};
+
+// Fletcher-style running sums over 64-bit little-endian words (zero padded tail)
+uint64_t mccbChecksum(const uint8_t *data, size_t size);
+
+bool isMccbFile(const string &filepath);
+
+// Header + payload, ready to be written as is
+vector<char> mccbSerialize(const Grid &matrix, MccbEncoding encoding = MccbEncoding::RAW8);
+
+// RAW8 files are mapped copy-on-write and adopted by matrix without copying; PACKED4 ones are decoded.
+// Returns false on any header/size/checksum mismatch, reporting INVALID_MCCB only if report is set.
+bool mccbLoad(const string &filepath, Grid &matrix, bool report = true);
+
+// Row by row reader of a .mccb file (--stream), working from a read-only mapping: each row is decoded
+// (PACKED4) or copied (RAW8) & validated as mccbLoad validates a whole grid, so only one row is resident
+// beside the mapped pages (clean, hence reclaimable). Errors are reported as INVALID_MCCB.
+class MccbRowReader {
+public:
+    explicit MccbRowReader(const string &filepath);
+
+    // Header & checksum valid (errors already reported)
+    bool isOpen() const { return payload != nullptr; }
+
+    // Decode & validate the next row into row, false past the last row or on error (see failed)
+    bool nextRow(vector<Cell> &row);
+
+    bool failed() const { return error; }
+
+private:
+    MappedFile mapped;
+    string filepath;
+    const uint8_t *payload = nullptr;
+    bool packed = false;
+    int border = 0;
+    int numOfRows = 0;
+    int numOfCols = 0;
+    int headerMin = 0, headerMax = 0;
+    int minVal = MAX_VAL + 1, maxVal = MIN_VAL - 1;  // running range of the rows read so far
+    size_t rowStride = 0;  // payload bytes per row (border included for RAW8)
+    size_t gapStart = 0;   // RAW8: first border byte not checked yet
+    int rowCnt = 0;
+    bool error = false;
+
+    bool fail(const string &reason);
+};
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "grid.hpp"
+
+using namespace std;
+
+// 4-bit cells (MIN_VAL..MAX_VAL fit in a nibble), 16 per 64-bit word: cell c of a row is
+// nibble c % 16 of word c / 16. Rows start on a word boundary. A zero (SENTINEL) row above & below
+// and the zero nibbles past the last column act as the sentinel border, so neighbor comparisons
+// need no bounds checks either - and run on whole words (SWAR) rather than cell by cell.
+class PackedGrid {
+public:
+    static constexpr int CELLS_PER_WORD = 16;
+    static constexpr uint64_t NIBBLE_LSB = 0x1111111111111111ULL;
+
+    PackedGrid();
+
+    explicit PackedGrid(const Grid &mat);
+
+    int rows() const { return nRows; }
+    int cols() const { return nCols; }
+    size_t size() const { return static_cast<size_t>(nRows) * nCols; }
+    bool empty() const { return nRows == 0 || nCols == 0; }
+    int wordsPerRow() const { return rowWords; }
+    size_t bytes() const { return words.size() * sizeof(uint64_t); }
+
+    // Min/max cell values, gathered while packing
+    int minValue() const { return minV; }
+    int maxValue() const { return maxV; }
+
+    // r may reach into the sentinel rows: [-1, rows]
+    const uint64_t *row(int r) const { return words.data() + static_cast<size_t>(r + 1) * rowWords; }
+
+    Cell operator()(int r, int c) const {
+        return static_cast<Cell>((row(r)[c / CELLS_PER_WORD] >> (4 * (c % CELLS_PER_WORD))) & 0xF);
+    }
+
+    // Valid-cell nibbles (their LSB) of word w
+    uint64_t validMask(int w) const { return (w + 1 < rowWords) ? NIBBLE_LSB : lastMask; }
+
+    Grid unpack() const;
+
+    void unpackRow(int r, Cell *dst) const;
+
+    // 0x1 in every nibble where a & b are equal
+    static uint64_t nibbleEq(uint64_t a, uint64_t b) {
+        uint64_t x = a ^ b;
+        x |= x >> 2;
+        x |= x >> 1;
+        return ~x & NIBBLE_LSB;
+    }
+
+    // Word w of a packed row, shifted so that each nibble holds its W (resp. E) neighbor
+    uint64_t westOf(const uint64_t *words, int w) const {
+        return (words[w] << 4) | (w > 0 ? words[w - 1] >> 60 : 0);
+    }
+    uint64_t eastOf(const uint64_t *words, int w) const {
+        return (words[w] >> 4) | (w + 1 < rowWords ? words[w + 1] << 60 : 0);
+    }
+
+private:
+    vector<uint64_t> words;
+    int nRows;
+    int nCols;
+    int rowWords;
+    uint64_t lastMask;
+    int minV;
+    int maxV;
+};
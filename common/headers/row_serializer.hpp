@@ -0,0 +1,29 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "grid.hpp"
+
+// Serialize one row into the "d,d,d\r\n" text layout: 2 * cols + 1 bytes at out, returns their end.
+// Cell c is written as its digit where mask[c] != 0 & as the delimiter elsewhere (blank).
+// Digits & delimiters are interleaved 16 (SSE2) or 32 (AVX2) cells at a time, scalar elsewhere.
+char *serializeRow(const Cell *cells, const uint8_t *mask, int cols, char delimiter, char *out);
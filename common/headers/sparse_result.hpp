@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "constants.hpp"
+
+using namespace std;
+
+// Sparse result encodings (--result_format) of the selected cells (e.g. a max region) of a window
+// of the matrix, in original matrix coordinates. Only the selected cells are encoded, so the output
+// follows the region size rather than the window area (except for the 1-bit mask).
+//
+// runs   (text):   "# runs rows=R cols=C origin=(r0,c0) cells=K", then one line per row holding
+//                  selected cells: "<row> <first>-<last> <first>-<last> ..." (inclusive column runs)
+// coords (text):   "# coords rows=R cols=C origin=(r0,c0) cells=K", then one "<row> <col>" line per cell
+// mask   (binary): 32-byte little-endian header, then R rows of ceil(C / 8) bytes, the bit c % 8
+//                  (LSB first) of byte c / 8 set for a selected cell:
+//   0 magic "MCCM" | 4 version (u16) | 6 reserved (u16) | 8 rows (u32) | 12 cols (u32)
+//   16 origin row (u32) | 20 origin col (u32) | 24 cells (u64)
+
+// Fills mask[c] (0 or 1) for every column c of the matrix row
+using RowMaskFunc = function<void(int row, uint8_t *mask)>;
+
+// Encode the window rows [firstRow, firstRow + rows) x cols [firstCol, firstCol + cols) of a matrix
+// maskWidth columns wide, one row mask at a time. format: one of RESULT_FORMATS but dense.
+vector<char> encodeSparse(const string &format,
+                          int firstRow, int rows,
+                          int firstCol, int cols,
+                          int maskWidth,
+                          const RowMaskFunc &rowMask);
+
+// File extension of a sparse format (with its dot): .txt, or .mccm for the mask
+string sparseExt(const string &format);
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "colors.hpp"
+
+using namespace std;
+
+// Terminal frame: text & color switches gathered in one buffer, then written at once.
+// Consecutive text of the same color shares a single color switch.
+// ANSI terminals (macOS, Linux) get the escape sequences inline & the frame in a single write;
+// the Windows console switches its text attribute once per color run.
+class TermFrame {
+public:
+    TermFrame() = default;
+    ~TermFrame();  // flushes
+
+    TermFrame(const TermFrame &) = delete;
+    TermFrame &operator=(const TermFrame &) = delete;
+
+    // Color of the text appended next
+    void color(unsigned short colorCode);
+
+    void append(char ch) { text.push_back(ch); }
+
+    size_t size() const { return text.size(); }
+
+    // Write the frame (the console color is reset after it) & start an empty one
+    void flush();
+
+private:
+    string text;
+    unsigned short currColor = DEFAULT_COLOR;
+    bool colored = false;  // a color switch was written since the last reset
+#ifdef _WIN32
+    vector<pair<size_t, unsigned short>> runs;  // text offset -> color of the text from there on
+#endif
+};
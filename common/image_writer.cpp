@@ -0,0 +1,215 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include "headers/image_writer.hpp"
+#include "headers/common.hpp"
+
+using namespace MyCommon;
+
+namespace {
+    constexpr uint8_t PNG_SIGNATURE[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    constexpr uint8_t ZLIB_HEADER[] = { 0x78, 0x01 };  // deflate, 32K window, no dictionary
+    constexpr size_t STORED_BLOCK_MAX = 65535;         // bytes per stored deflate block
+
+    // CRC32 (PNG / zlib polynomial) lookup tables, sliced by 8 bytes
+    constexpr auto CRC_TABLES = [] {
+        array<array<uint32_t, 256>, 8> tables{};
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++)
+                crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+            tables[0][i] = crc;
+        }
+        for (uint32_t i = 0; i < 256; i++) {
+            for (int slice = 1; slice < 8; slice++)
+                tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+        }
+        return tables;
+    }();
+
+    void putBE32(uint8_t *out, uint32_t value) {
+        out[0] = static_cast<uint8_t>(value >> 24);
+        out[1] = static_cast<uint8_t>(value >> 16);
+        out[2] = static_cast<uint8_t>(value >> 8);
+        out[3] = static_cast<uint8_t>(value);
+    }
+
+    // Stored block header: BFINAL, BTYPE 00 (byte aligned), LEN & its complement (little-endian)
+    void appendStoredHeader(vector<uint8_t> &out, size_t len, bool last) {
+        const uint16_t len16 = static_cast<uint16_t>(len);
+        const uint8_t header[] = { uint8_t(last ? 1 : 0),
+                                   uint8_t(len16 & 0xFF), uint8_t(len16 >> 8),
+                                   uint8_t(~len16 & 0xFF), uint8_t(uint16_t(~len16) >> 8) };
+        out.insert(out.end(), begin(header), end(header));
+    }
+}
+
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t size) {
+    const auto &t = CRC_TABLES;
+    crc = ~crc;
+    for (; size >= 8; data += 8, size -= 8) {
+        const uint32_t lo = crc ^ (uint32_t(data[0]) | uint32_t(data[1]) << 8 |
+                                   uint32_t(data[2]) << 16 | uint32_t(data[3]) << 24);
+        crc = t[7][lo & 0xFF] ^ t[6][(lo >> 8) & 0xFF] ^ t[5][(lo >> 16) & 0xFF] ^ t[4][lo >> 24] ^
+              t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+    }
+    while (size--)
+        crc = t[0][(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+// Sums are reduced every 5552 bytes, the most that can't overflow 32 bits
+uint32_t adler32Update(uint32_t adler, const uint8_t *data, size_t size) {
+    constexpr uint32_t MOD = 65521;
+    constexpr size_t NMAX = 5552;
+    uint32_t a = adler & 0xFFFF, b = adler >> 16;
+    while (size) {
+        const size_t block = min(size, NMAX);
+        for (size_t i = 0; i < block; i++) {
+            a += data[i];
+            b += a;
+        }
+        a %= MOD;
+        b %= MOD;
+        data += block;
+        size -= block;
+    }
+    return b << 16 | a;
+}
+
+ImageWriter::ImageWriter(const string &filepath, int width, int height, ImageFormat format)
+    : file(filepath, ios::out | ios::binary), filepath(filepath),
+      width(width), height(height), format(format) {
+    if (!file.is_open()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext(filepath));
+        fail = true;
+        return;
+    }
+    if (format == ImageFormat::PPM) {
+        const string header = "P6\n" + to_string(width) + " " + to_string(height) + "\n255\n";
+        file.write(header.data(), static_cast<streamsize>(header.size()));
+    }
+    else {
+        uint8_t ihdr[13];
+        putBE32(ihdr, static_cast<uint32_t>(width));
+        putBE32(ihdr + 4, static_cast<uint32_t>(height));
+        ihdr[8] = 8;   // bit depth
+        ihdr[9] = 2;   // color type: RGB
+        ihdr[10] = 0;  // compression: deflate
+        ihdr[11] = 0;  // filter method: adaptive (every row uses filter type None)
+        ihdr[12] = 0;  // no interlace
+        file.write(reinterpret_cast<const char *>(PNG_SIGNATURE), sizeof(PNG_SIGNATURE));
+        writeChunk("IHDR", ihdr, sizeof(ihdr));
+        payload.assign(begin(ZLIB_HEADER), end(ZLIB_HEADER));
+    }
+    checkStream();
+}
+
+ImageWriter::~ImageWriter() {
+    finish();
+}
+
+// PNG: the rows of a band (each led by its filter type byte) become the stored blocks of one IDAT chunk
+void ImageWriter::writeRows(const uint8_t *rgb, int rows) {
+    if (fail || finished || rows <= 0)
+        return;
+    const size_t rowBytes = static_cast<size_t>(width) * 3;
+    rowsWritten += rows;
+    if (format == ImageFormat::PPM) {
+        file.write(reinterpret_cast<const char *>(rgb), static_cast<streamsize>(rowBytes * rows));
+        checkStream();
+        return;
+    }
+
+    const size_t rawBytes = (rowBytes + 1) * rows;
+    payload.reserve(payload.size() + rawBytes + (rawBytes / STORED_BLOCK_MAX + 1) * 5);
+    size_t blockLeft = 0;
+    for (int r = 0; r < rows; r++) {
+        const uint8_t filterType = 0;
+        const uint8_t *row = rgb + rowBytes * r;
+        adler = adler32Update(adler, &filterType, 1);
+        adler = adler32Update(adler, row, rowBytes);
+        // the raw bytes of the band, cut into blocks of up to STORED_BLOCK_MAX
+        for (size_t offset = 0; offset <= rowBytes;) {
+            if (!blockLeft) {
+                blockLeft = min(STORED_BLOCK_MAX, rawBytes - ((rowBytes + 1) * r + offset));
+                appendStoredHeader(payload, blockLeft, false);
+            }
+            const size_t piece = min(blockLeft, rowBytes + 1 - offset);
+            if (offset == 0) {
+                payload.push_back(filterType);
+                payload.insert(payload.end(), row, row + piece - 1);
+            }
+            else
+                payload.insert(payload.end(), row + offset - 1, row + offset - 1 + piece);
+            offset += piece;
+            blockLeft -= piece;
+        }
+    }
+    writeChunk("IDAT", payload.data(), payload.size());
+    payload.clear();
+    checkStream();
+}
+
+bool ImageWriter::finish() {
+    if (finished)
+        return !fail;
+    finished = true;
+    if (!fail && rowsWritten != height)
+        fail = true;  // fewer rows than announced in the header
+    if (!fail && format == ImageFormat::PNG) {
+        appendStoredHeader(payload, 0, true);
+        payload.resize(payload.size() + 4);
+        putBE32(payload.data() + payload.size() - 4, adler);
+        writeChunk("IDAT", payload.data(), payload.size());
+        writeChunk("IEND", nullptr, 0);
+        payload.clear();
+        payload.shrink_to_fit();
+    }
+    if (file.is_open()) {
+        file.close();
+        checkStream();
+    }
+    return !fail;
+}
+
+void ImageWriter::writeChunk(const char type[4], const uint8_t *data, size_t size) {
+    uint8_t header[8];
+    putBE32(header, static_cast<uint32_t>(size));
+    memcpy(header + 4, type, 4);
+    uint32_t crc = crc32Update(0, header + 4, 4);
+    if (size)
+        crc = crc32Update(crc, data, size);
+    uint8_t trailer[4];
+    putBE32(trailer, crc);
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    if (size)
+        file.write(reinterpret_cast<const char *>(data), static_cast<streamsize>(size));
+    file.write(reinterpret_cast<const char *>(trailer), sizeof(trailer));
+}
+
+void ImageWriter::checkStream() {
+    if (!fail && file.fail()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext(filepath));
+        fail = true;
+    }
+}
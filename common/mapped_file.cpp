@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#ifdef _WIN32
+    #define NOMINMAX
+    #include <Windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "headers/mapped_file.hpp"
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const string &filepath, bool copyOnWrite) {
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, copyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY,
+                                            0, 0, nullptr);
+        if (mapping) {
+            addr = MapViewOfFile(mapping, copyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
+            if (addr)
+                length = static_cast<size_t>(fileSize.QuadPart);
+            CloseHandle(mapping);  // the view keeps the mapping alive
+        }
+    }
+    CloseHandle(file);
+}
+
+MappedFile::~MappedFile() {
+    if (addr)
+        UnmapViewOfFile(addr);
+}
+
+#else
+
+MappedFile::MappedFile(const string &filepath, bool copyOnWrite) {
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        const int prot = copyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+        void *mapped = mmap(nullptr, static_cast<size_t>(st.st_size), prot, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            addr = mapped;
+            length = static_cast<size_t>(st.st_size);
+            madvise(addr, length, MADV_SEQUENTIAL);
+        }
+    }
+    close(fd);  // the mapping stays valid
+}
+
+MappedFile::~MappedFile() {
+    if (addr)
+        munmap(addr, length);
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MCCA_SSE2
+#endif
+
+#include "headers/mat_parser_simd.hpp"
+
+namespace {
+
+    constexpr size_t BLOCK = 64;
+
+    // Byte classes of a 64-byte block, one bit per byte
+    struct BlockMasks {
+        uint64_t digit;  // '1'-'9'
+        uint64_t eol;    // CR, LF
+        uint64_t valid;  // digit, delimiter or EOL
+    };
+
+#if defined(__AVX2__)
+
+    BlockMasks classify32(const char *p) {
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+        auto eq = [&](char c) { return _mm256_cmpeq_epi8(b, _mm256_set1_epi8(c)); };
+        const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(b, _mm256_set1_epi8('0')),
+                                               _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), b));
+        const __m256i eol = _mm256_or_si256(eq('\r'), eq('\n'));
+        const __m256i delim = _mm256_or_si256(_mm256_or_si256(eq(' '), eq(',')),
+                                              _mm256_or_si256(eq(';'), eq('\t')));
+        const __m256i valid = _mm256_or_si256(digit, _mm256_or_si256(eol, delim));
+        return { static_cast<uint32_t>(_mm256_movemask_epi8(digit)),
+                 static_cast<uint32_t>(_mm256_movemask_epi8(eol)),
+                 static_cast<uint32_t>(_mm256_movemask_epi8(valid)) };
+    }
+
+    BlockMasks classify(const char *p) {
+        const BlockMasks lo = classify32(p), hi = classify32(p + 32);
+        return { lo.digit | hi.digit << 32, lo.eol | hi.eol << 32, lo.valid | hi.valid << 32 };
+    }
+
+#elif defined(MCCA_SSE2)
+
+    BlockMasks classify16(const char *p) {
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        auto eq = [&](char c) { return _mm_cmpeq_epi8(b, _mm_set1_epi8(c)); };
+        const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(b, _mm_set1_epi8('0')),
+                                            _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), b));
+        const __m128i eol = _mm_or_si128(eq('\r'), eq('\n'));
+        const __m128i delim = _mm_or_si128(_mm_or_si128(eq(' '), eq(',')),
+                                           _mm_or_si128(eq(';'), eq('\t')));
+        const __m128i valid = _mm_or_si128(digit, _mm_or_si128(eol, delim));
+        return { static_cast<uint64_t>(_mm_movemask_epi8(digit)),
+                 static_cast<uint64_t>(_mm_movemask_epi8(eol)),
+                 static_cast<uint64_t>(_mm_movemask_epi8(valid)) };
+    }
+
+    BlockMasks classify(const char *p) {
+        BlockMasks res = { 0, 0, 0 };
+        for (int i = 0; i < 4; i++) {
+            const BlockMasks part = classify16(p + 16 * i);
+            res.digit |= part.digit << (16 * i);
+            res.eol |= part.eol << (16 * i);
+            res.valid |= part.valid << (16 * i);
+        }
+        return res;
+    }
+
+#else
+
+    BlockMasks classify(const char *p) {
+        BlockMasks res = { 0, 0, 0 };
+        for (size_t i = 0; i < BLOCK; i++) {
+            const char ch = p[i];
+            const uint64_t bit = uint64_t(1) << i;
+            if (ch >= '1' && ch <= '9')
+                res.digit |= bit;
+            else if (ch == '\r' || ch == '\n')
+                res.eol |= bit;
+            else if (ch != ' ' && ch != ',' && ch != ';' && ch != '\t')
+                continue;
+            res.valid |= bit;
+        }
+        return res;
+    }
+
+#endif
+
+    // Classify the block at offset, padding a partial last block with delimiters
+    BlockMasks classifyAt(const char *data, size_t size, size_t offset) {
+        if (offset + BLOCK <= size)
+            return classify(data + offset);
+        char tail[BLOCK];
+        memset(tail, ' ', BLOCK);
+        memcpy(tail, data + offset, size - offset);
+        return classify(tail);
+    }
+
+}
+
+bool parseMatSimd(const char *data, size_t size, Grid &matrix) {
+    // 1st pass: validate & measure
+    size_t rowCells = 0, rowLen = 0, rows = 0;
+    uint64_t carry = 0;  // digit at the last byte of the previous block
+
+    auto endRow = [&]() {
+        if (rowCells == 0)  // rows without cells are skipped
+            return true;
+        if (rows == 0)
+            rowLen = rowCells;
+        else if (rowCells != rowLen)
+            return false;
+        ++rows;
+        rowCells = 0;
+        return true;
+    };
+
+    for (size_t offset = 0; offset < size; offset += BLOCK) {
+        const BlockMasks masks = classifyAt(data, size, offset);
+        if (~masks.valid)
+            return false;
+        if (masks.digit & (masks.digit << 1 | carry))
+            return false;
+        carry = masks.digit >> (BLOCK - 1);
+
+        uint64_t digits = masks.digit;
+        for (uint64_t eols = masks.eol; eols; eols &= eols - 1) {
+            const uint64_t before = (eols & (~eols + 1)) - 1;
+            rowCells += popcount(digits & before);
+            digits &= ~before;
+            if (!endRow())
+                return false;
+        }
+        rowCells += popcount(digits);
+    }
+    if (!endRow())
+        return false;
+
+    if (rows == 0)
+        return true;
+    if (rows > INT_MAX || rowLen > INT_MAX)
+        return false;
+
+    // 2nd pass: decode the digits in order - every row holds exactly rowLen of them
+    const int numOfRows = static_cast<int>(rows), numOfCols = static_cast<int>(rowLen);
+    Grid grid(numOfRows, numOfCols);
+    int r = 0, c = 0;
+    Cell *out = grid.row(0);
+    for (size_t offset = 0; offset < size; offset += BLOCK) {
+        const char *block = data + offset;
+        for (uint64_t digits = classifyAt(data, size, offset).digit; digits; digits &= digits - 1) {
+            out[c] = static_cast<Cell>(block[countr_zero(digits)] - '0');
+            if (++c == numOfCols) {
+                c = 0;
+                if (++r < numOfRows)
+                    out = grid.row(r);
+            }
+        }
+    }
+    matrix = std::move(grid);
+    return true;
+}
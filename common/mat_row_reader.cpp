@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#include "headers/mat_row_reader.hpp"
+
+using namespace MyCommon;
+
+MatRowReader::MatRowReader(const string &filepath, size_t chunkSize) :
+    source(filepath, chunkSize), chunk(chunkSize) {}
+
+bool MatRowReader::fetch() {
+    if (pos < len)
+        return true;
+    len = source.read(chunk.data(), chunk.size());
+    pos = 0;
+    return len > 0;
+}
+
+bool MatRowReader::readLine() {
+    line.clear();
+    // Skip CRLF chars at EOL
+    while (fetch() && (chunk[pos] == '\n' || chunk[pos] == '\r')) {
+        if (chunk[pos] == '\n')
+            ++rowCnt;
+        ++pos;
+    }
+    while (fetch()) {
+        const char *begin = chunk.data() + pos;
+        const char *end = chunk.data() + len;
+        const char *eol = begin;
+        while (eol < end && *eol != '\n' && *eol != '\r')
+            ++eol;
+        line.insert(line.end(), begin, eol);
+        pos += eol - begin;
+        if (eol < end)
+            break;
+    }
+    return !line.empty();
+}
+
+bool MatRowReader::nextRow(vector<Cell> &row) {
+    while (!error && readLine()) {
+        if (source.failed()) {  // a truncated/corrupt compressed file, reported already
+            error = true;
+            break;
+        }
+        if (!parseRow(line.data(), line.data() + line.size(), rowCnt, row)) {
+            error = true;
+            break;
+        }
+        if (row.empty())
+            continue;
+        if (numOfRows == 0) {
+            rowLen = row.size();
+        }
+        else if (row.size() != rowLen) {
+            handleError(ErrCode::ROW_LEN_MISMATCH, rowCnt);
+            error = true;
+            break;
+        }
+        ++numOfRows;
+        return true;
+    }
+    return false;
+}
+
+bool MatRowReader::parseRow(const char *begin, const char *end, int rowCnt, vector<Cell> &row) {
+    row.clear();
+    int col_cnt = 0;
+    bool in_number = false;
+
+    for (const char *p = begin; p < end; ++p) {
+        if (isdigit(*p)) {  // Only process digits (1-9)
+            // detect a multi-digit scenario (out of range)
+            if (in_number) {
+                int number = 0;
+                for (const char *d = p - 1; d < end && isdigit(*d); ++d)
+                    number = number * 10 + (*d - '0');
+                handleError(ErrCode::MULTIDIGIT, rowCnt, col_cnt - 1, number);
+                return false;
+            }
+
+            int value = *p - '0';
+
+            if (value == 0) {
+                handleError(ErrCode::INVALID_RANGE, value, "Matrix", MIN_VAL, MAX_VAL);
+                return false;
+            }
+
+            row.emplace_back(static_cast<Cell>(value));
+            in_number = true;
+            ++col_cnt;
+        }
+        // Valid delimiters
+        else if (*p == ' ' || *p == ',' || *p == ';' || *p == '\t') {
+            in_number = false;  // We're no longer in the middle of a number
+            if (*p == '\t')
+                col_cnt += TABWIDTH - (col_cnt % TABWIDTH);
+            else
+                ++col_cnt;
+        }
+        else {
+            handleError(ErrCode::INVALID_CHAR, *p, rowCnt, col_cnt);
+            return false;
+        }
+    }
+    return true;
+}
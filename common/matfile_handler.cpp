@@ -17,6 +17,8 @@
  * The original author, Yaron Dayan, must be credited in all derivative works.
  */
 
+#include <algorithm>
+
 #include "headers/matfile_handler.hpp"
 
 using namespace MyCommon;
@@ -31,10 +33,14 @@ MatFileHandler::MatFileHandler():
     min_v(DEFAULT_MIN_V),
     max_v(DEFAULT_MAX_V),
     sqmat(DEFAULT_SQMAT),
+    threads(DEFAULT_THREADS),
     destpath(DEFAULT_ROOTDIR),
     confirm(EN_CONFIRM),
     txt(EN_TXT),
     overwrite(EN_OVR),
+    mccb(false),
+    mccbEncoding(MccbEncoding::RAW8),
+    compression(Compression::NONE),
     parsedMatIdx(0),
     matInfo({0, 0, 0, 0}),  // n rows, m cols, min_value, max_value
     filename("")
@@ -43,12 +49,14 @@ MatFileHandler::MatFileHandler():
 const string MatFileHandler::updatePath(int rows, int cols,
                                         int min_value, int max_value) const {
 
-    const string ext = txt ? "txt" : "csv";
+    const string ext = mccb ? "mccb" : txt ? "txt" : "csv";
 
     ostringstream filepath;
     filepath << destpath << "/mat_"
         << rows << "_" << cols << "_"
         << min_value << "_" << max_value << "." << ext;
+    if (!mccb)
+        filepath << compressionExt(compression);
     return filepath.str();
 }
 
@@ -73,20 +81,22 @@ void MatFileHandler::updateFileParams(string destpath, bool confirm, bool txt, b
 
 const string MatFileHandler::updatePath(const string &filename) const {
 
-    const string ext = txt ? "txt" : "csv";
+    const string ext = mccb ? "mccb" : txt ? "txt" : "csv";
     ostringstream filepath, default_fname;
-    size_t matRowLen = currMat[0].size();
-    default_fname << "/mat_" << currMat.size() << "_" << matRowLen;
+    int matRowLen = currMat.cols();
+    default_fname << "/mat_" << currMat.rows() << "_" << matRowLen;
     const string fname = (filename != "") ? filename : default_fname.str();
     filepath << destpath
-        << "/mat_" << currMat.size() << "_" << matRowLen
+        << "/mat_" << currMat.rows() << "_" << matRowLen
         << "." << ext;
+    if (!mccb)
+        filepath << compressionExt(compression);
     return filepath.str();
 }
 
 // parsed matrix filename updater 
 string MatFileHandler::updateStrByIntVect(vector<int> vect) const {
-    const string ext = this->txt ? "txt" : "csv";
+    const string ext = mccb ? "mccb" : txt ? "txt" : "csv";
     ostringstream oss;
     oss << "mat" << this->parsedMatIdx << "_";
     for (auto it = vect.begin(); it != vect.end(); ++it) {
@@ -99,21 +109,22 @@ string MatFileHandler::updateStrByIntVect(vector<int> vect) const {
     return oss.str();
 }
 
-void MatFileHandler::displayMat(const vector<vector<int>> &mat) {
+void MatFileHandler::displayMat(const Grid &mat) {
     ostringstream oss;
-    for (const auto &row : mat) {
-        for (int value : row) {
-            oss << value << ' ';
+    for (int r = 0; r < mat.rows(); r++) {
+        const Cell *row = mat.row(r);
+        for (int c = 0; c < mat.cols(); c++) {
+            oss << itoc(row[c]) << ' ';
         }
         oss << '\n';
     }
     formatTxt(oss, LIGHT_CYAN);
 }
 
-void MatFileHandler::displayMatrices(const vector<vector<vector<int>>> &matVect) {
+void MatFileHandler::displayMatrices(const vector<Grid> &matVect) {
     for (const auto &mat : matVect) {
         displayMat(mat);
-        string separator(2 * mat[0].size(), '-');
+        string separator(2 * mat.cols(), '-');
         formatTxt(separator, LIGHT_CYAN);
     }
 }
@@ -138,53 +149,40 @@ bool MatFileHandler::isValidMatSpec(int rows, int cols) const {
     return true;
 }
 
-vector<vector<int>> MatFileHandler::genRndMat(int rows, int cols, mt19937 gen) {
-    if (!isValidMatSpec(rows, cols))
-        return {};
-
-    ostringstream info;
-    info << "Generating a random " << rows << "x" << cols
-        << " matrix with values " << withinRange(min_v, max_v) << "\n";
-    formatTxt(info, LIGHT_MAGENTA);
-
-    vector<vector<int>> mat(rows, vector<int>(cols));
-    for (int row = 0; row < rows; row++) {
-        for (int col = 0; col < cols; col++) {
-            mat[row][col] = rndIntInRange(gen, min_v, max_v);
-        }
-    }
-    return mat;
+uint64_t MatFileHandler::rndMatSeed(int rows, int cols) const {
+    if (seed) // every file of a sweep gets its own stream
+        return splitMix64(*seed ^ (static_cast<uint64_t>(rows) << 32 | static_cast<uint32_t>(cols)));
+    random_device rd;
+    return static_cast<uint64_t>(rd()) << 32 | rd();
 }
 
-vector<vector<int>> MatFileHandler::genRndMatWrapper(int rows, int cols, optional<unsigned int> seed) {
-    mt19937 gen;
-    if (seed) {
-        gen.seed(*seed); // Use the provided seed for deterministic output
-    }
-    else {
-        random_device rd;
-        gen.seed(rd());
-    }
-    return genRndMat(rows, cols, gen);
+Grid MatFileHandler::genRndMat(int rows, int cols, uint64_t matSeed, int rowThreads) const {
+    Grid mat(rows, cols);
+    forRowStrips(rows, rowThreads, [&](int firstRow, int lastRow) {
+        for (int row = firstRow; row < lastRow; row++)
+            rndFillRow(matSeed, row, mat.row(row), cols, min_v, max_v);
+    });
+    return mat;
 }
 
 
-vector<vector<int>> MatFileHandler::parseMat(const string &matrixStr) {
-    vector<vector<int>> matrix;
+Grid MatFileHandler::parseMat(const string &matrixStr) {
+    vector<Cell> cells;
+    int rows = 0;
     string rowToken;
     bool isFirstRow = true;
     const size_t strLength = matrixStr.length();
 
     if (strLength < 3) {
         handleError(ErrCode::EMPTY_STR, ErrorContext());
-        return { { 0 } };
+        return {};
     }
 
     const string trimmedString = matrixStr.substr(1, strLength - 2);
 
     if (trimmedString.empty()) {
         handleError(ErrCode::EMPTY_STR, ErrorContext());
-        return { { 0 } };
+        return {};
     }
 
     istringstream matrixStream(trimmedString);
@@ -196,35 +194,34 @@ vector<vector<int>> MatFileHandler::parseMat(const string &matrixStr) {
             delimFix(rowToken, "{},");
             if (vector<int> row = validateRow(rowToken); row[0] != -1) {
                 if (isFirstRow) {
-                    matrix.emplace_back(std::move(row));
                     isFirstRow = false;
-                    row_len = matrix[0].size();
+                    row_len = row.size();
                 }
-                else {
-                    // Validate subsequent row length
-                    if (row.size() != row_len) {
-                        handleError(ErrCode::ROW_LEN_MISMATCH, ErrorContext());
-                        return { { 0 } };
-                    }
-                    matrix.emplace_back(std::move(row));
+                // Validate subsequent row length
+                else if (row.size() != row_len) {
+                    handleError(ErrCode::ROW_LEN_MISMATCH, ErrorContext());
+                    return {};
                 }
+                for (int value : row)
+                    cells.emplace_back(static_cast<Cell>(value));
+                ++rows;
             }
             else {
                 handleError(ErrCode::INVALID_MAT, ErrorContext());
-                return { { 0 } };
+                return {};
             }
         }
     }
-    return matrix;
+    return Grid(rows, static_cast<int>(row_len), std::move(cells));
 }
 
-vector<vector<vector<int>>> MatFileHandler::parseMatrices(const string &matricesStr) {
-    vector<vector<vector<int>>> matrices;
+vector<Grid> MatFileHandler::parseMatrices(const string &matricesStr) {
+    vector<Grid> matrices;
     istringstream matricesStream(matricesStr);
     for (const string &matStr : strSplit(matricesStr)) {
         if (matStr != " ") {
-            currMat = std::move(parseMat(matStr));
-            if (!currMat.empty() && currMat[0][0]) {
+            currMat = parseMat(matStr);
+            if (!currMat.empty()) {
                 matrices.emplace_back(std::move(currMat));
             }
             else // fail right after the first invalid matrix / substring
@@ -257,6 +254,8 @@ void MatFileHandler::calcSizeMatFiles() const {
     double sum_cols = n_cols * (c1 + cn + 1);
 
     double totalSize = sum_rows * sum_cols;
+    if (mccb)  // ~1 byte per cell (raw8), half of it packed, instead of digit + delimiter
+        totalSize /= (mccbEncoding == MccbEncoding::PACKED4) ? 4 : 2;
 
     handleDiskSpace(totalSize, MAX_FILE_SIZE_MB);
 }
@@ -280,172 +279,152 @@ void MatFileHandler::calcSizeSqMatFiles() const {
     double sum_rows_sq = s1 + s2 + s3;
 
     double totalSize = 2 * sum_rows_sq + sum_rows;
+    if (mccb)
+        totalSize /= (mccbEncoding == MccbEncoding::PACKED4) ? 4 : 2;
 
     handleDiskSpace(totalSize, MAX_FILE_SIZE_MB);
 }
 
 // Load matrix from file
-// Supporting csv/txt comma/tab/semicolon separated ints
-bool MatFileHandler::matLoader(vector<vector<int>> &matrix, const string &filepath) {
-    ifstream file(filepath, ios::binary);
-    if (!file.is_open()) {
-        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext());
-        return false;
-    }
-
-    size_t file_size = fGetSize(filepath);
-
-    // Read the entire file into a buffer
-    vector<char> buffer(file_size);
-    file.read(buffer.data(), file_size);
-    file.close();
-
-    size_t idx = 0;
-    int row_cnt = 0;
-    int col_cnt = 0;
-    vector<int> row;
-    bool in_number = false;
-    bool isFirstRow = true;
-    size_t row_len = 0;
+// Supporting csv/txt comma/tab/semicolon separated ints & .mccb binary files
+// Map the file & take the vectorized path, falling back to the scalar parser on any anomaly
+// (invalid input included, which it reports with exact row/col positions)
+bool MatFileHandler::matLoader(Grid &matrix, const string &filepath) {
+    return matLoaderQuiet(matrix, filepath) || matLoaderFallback(matrix, filepath);
+}
 
-    // Loop through the buffer and parse integers into rows
-    while (idx < buffer.size()) {
-        while (idx < buffer.size() && (buffer[idx] != '\n' && buffer[idx] != '\r')) {
-            if (isdigit(buffer[idx])) {  // Only process digits (1-9)
-                // detect a multi-digit scenario (out of range)
-                if (in_number) {
-                    handleError(ErrCode::MULTIDIGIT, row_cnt, col_cnt - 1, evalNum(idx - 1, buffer));
-                    return false;
-                }
+bool MatFileHandler::matLoaderQuiet(Grid &matrix, const string &filepath) const {
+    if (isMccbFile(filepath))
+        return mccbLoad(filepath, matrix, false);
+    if (fCompression(filepath) != Compression::NONE) {
+        vector<char> text;
+        return fDecompress(filepath, text, false) && parseMatSimd(text.data(), text.size(), matrix);
+    }
+    MappedFile mapped(filepath);
+    return mapped.isOpen() && parseMatSimd(mapped.data(), mapped.size(), matrix);
+}
 
-                int value = buffer[idx] - '0';
+bool MatFileHandler::matLoaderFallback(Grid &matrix, const string &filepath) {
+    if (isMccbFile(filepath))
+        return mccbLoad(filepath, matrix);
+    return matLoaderScalar(matrix, filepath);
+}
 
-                if (value == 0) {
-                    handleError(ErrCode::INVALID_RANGE, value, "Matrix", MIN_VAL, MAX_VAL);
-                    return false;
-                }
+bool MatFileHandler::matLoaderScalar(Grid &matrix, const string &filepath) {
+    MatRowReader reader(filepath);
+    if (!reader.isOpen()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext());
+        return false;
+    }
 
-                row.emplace_back(value);
-                in_number = true;
-                ++col_cnt;
-            }
-            // Valid delimiters
-            else if (buffer[idx] == ' ' || buffer[idx] == ',' || buffer[idx] == ';' || buffer[idx] == '\t') {
-                in_number = false;  // We're no longer in the middle of a number
-                if (buffer[idx] == '\t')
-                    col_cnt += TABWIDTH - (col_cnt % TABWIDTH);
-                else
-                    ++col_cnt;
-            }
-            else {
-                handleError(ErrCode::INVALID_CHAR, buffer[idx], row_cnt, col_cnt);
-                return false;
-            }
-            ++idx;
-        }
+    vector<Cell> cells;
+    cells.reserve(fGetSize(filepath) / 2 + 1);  // at least one delimiter/EOL byte per cell
+    vector<Cell> row;
 
-        if (!row.empty()) {
-            if (isFirstRow) {
-                matrix.emplace_back(std::move(row));
-                isFirstRow = false;
-                row_len = matrix[0].size();
-            }
-            else {
-                if (row.size() != row_len) {
-                    handleError(ErrCode::ROW_LEN_MISMATCH, row_cnt);
-                    return false;
-                }
-                matrix.emplace_back(std::move(row));
-            }
-        }
+    // Parse the file row by row
+    while (reader.nextRow(row))
+        cells.insert(cells.end(), row.begin(), row.end());
+    if (reader.failed())
+        return false;
 
-        // Skip CRLF chars at EOL
-        while (idx < buffer.size() && (buffer[idx] == '\n' || buffer[idx] == '\r')) {
-            in_number = false;
-            if (buffer[idx] == '\n')
-                ++row_cnt;
-            ++idx;
-        }
-        // Get ready for next row 
-        col_cnt = 0;
-        row.clear();
-    }
+    if (reader.rows() > 0)
+        matrix = Grid(reader.rows(), reader.cols(), std::move(cells));
     return true;
 }
 
-// load matrices, return them & their location
-vector<pair<string, vector<vector<int>>>> MatFileHandler::fLoadMatrices() {
-    vector<pair<string, vector<vector<int>>>> files;
-    bool success = false;
-
-    formatTxt("Loading matrix files - please hang on a minute...\n", LIGHT_CYAN);
+// list the matrix files under destpath (output files excluded)
+vector<string> MatFileHandler::listMatFiles() const {
+    vector<string> filepaths;
     bool directoryEmpty = true;
-    int filecount = 0;
     for (const auto &entry : filesystem::directory_iterator(destpath)) {
         const auto &path = entry.path();
-        const auto ext = path.extension();
+        auto ext = path.extension();
+        const Compression format = fCompression(path.string());
+        if (format != Compression::NONE) {
+            if (!isCompressionSupported(format))
+                continue;
+            ext = path.stem().extension();  // mat.txt.gz -> .txt
+            if (ext == ".mccb")
+                continue;
+        }
         string filename = path.filename().string();
         size_t output_file = filename.find("out");
-        if ((ext == ".txt" || ext == ".csv") && output_file == string::npos) {
+        if ((ext == ".txt" || ext == ".csv" || ext == ".mccb") && output_file == string::npos) {
             directoryEmpty = false;
-            string filepath = path.string();
-            ostringstream oss;
-            oss << ++filecount << ")" << filepath;
-            formatTxt(oss, LIGHT_CYAN);
-            vector<vector<int>> mat;
-            success = matLoader(mat, filepath);
-            cout << endl;
-            if (!mat.empty() && success) {
-                files.emplace_back(filepath, std::move(mat));
-            }
+            filepaths.emplace_back(path.string());
         }
     }
     if (directoryEmpty) {
         handleError(ErrCode::EMPTY_DIR, destpath);
         exit(1);
     }
-    else {
-        formatTxt("\nLoading - Complete!\n\n", LIGHT_CYAN);
+    // skip the text sources of converted files, so that repeat runs skip parsing
+    unordered_set<string> converted;
+    for (const string &filepath : filepaths) {
+        if (isMccbFile(filepath))
+            converted.insert(fRemoveExt(filepath));
+    }
+    erase_if(filepaths, [&](const string &filepath) {
+        return !isMccbFile(filepath) && converted.contains(fRemoveExt(filepath));
+    });
+    return filepaths;
+}
+
+void MatFileHandler::convertMatFiles(const string &format) {
+    txt = format == "txt";
+    mccb = format == "mccb";
+    int filecount = 0;
+    for (const string &filepath : listMatFiles()) {
+        const string target = fRemoveExt(filepath) + "." + format + (mccb ? "" : compressionExt(compression));
+        if (filepath == target)
+            continue;
+        ostringstream oss;
+        oss << ++filecount << ")" << filepath;
+        formatTxt(oss, LIGHT_CYAN);
+        if (!matLoader(currMat, filepath) || currMat.empty())
+            continue;
+        fWriteMat(target, true);
     }
-    return files;
+    if (filecount == 0)
+        formatTxt("Nothing to convert - all matrix files are " + format + " already.", LIGHT_YELLOW);
 }
 
-//fill buffer with generated random matrix 
-vector <char> MatFileHandler::fillBuffRndMat(int rows, int cols, mt19937 gen) {
-    return fillBuffer([](int, int) { return true; }, // No condition, all cells are valid
-                      [&](int, int) { return rndCharInRange(gen, min_v, max_v); },
-                      0, rows - 1, 0, cols - 1
-                     );
+//fill buffer with generated random matrix
+vector<char> MatFileHandler::fillBuffRndMat(int rows, int cols, uint64_t matSeed, int rowThreads) const {
+    auto buffer = bufferInit(0, rows - 1, 0, cols - 1);
+    fillRndRows(buffer.data(), 0, rows, cols, matSeed, rowThreads);
+    return buffer;
+}
+
+// each strip draws its rows & serializes them in place
+void MatFileHandler::fillRndRows(char *out, int firstRow, int lastRow, int cols,
+                                 uint64_t matSeed, int rowThreads) const {
+    const char delimiter = txt ? ' ' : ',';
+    const size_t rowSize = 2 * static_cast<size_t>(cols) + 1;
+    forRowStrips(lastRow - firstRow, rowThreads, [&](int stripFirst, int stripLast) {
+        vector<Cell> cells(cols);
+        const vector<uint8_t> mask(cols, 1);
+        for (int i = stripFirst; i < stripLast; i++) {
+            rndFillRow(matSeed, firstRow + i, cells.data(), cols, min_v, max_v);
+            serializeRow(cells.data(), mask.data(), cols, delimiter, out + i * rowSize);
+        }
+    });
 }
 
 vector<char> MatFileHandler::fillBuffMat() {
 
-    if (currMat.empty() || currMat[0].empty()) {
+    if (currMat.empty()) {
         handleError(ErrCode::MAT_EMPTY, ErrorContext());
         return {};
     }
 
-    int rows = static_cast<int>(currMat.size());
-    int cols = static_cast<int>(currMat[0].size());
-
     // No condition - all matrix cells are valid!
-    auto cellCond = [](int, int) { return true; };
-    auto valueCond = [&](int r, int c) { return itoc(currMat[r][c]); };
-
-    return fillBuffer(cellCond, 
-                      valueCond,
-                      0, rows - 1, 0, cols - 1
-                     );
-}
-
-vector<char> MatFileHandler::fillBuffRndMat(int rows, int cols) {
-    random_device rd;
-    mt19937 gen(rd());
-    return fillBuffRndMat(rows, cols, gen);
+    return fillBufferRows([&](int r, uint8_t *) { return currMat.row(r); },
+                          currMat.rows(), currMat.cols());
 }
 
 //initialize a buffer
-vector<char> MatFileHandler::bufferInit(int min_r, int max_r, int min_c, int max_c) {
+vector<char> MatFileHandler::bufferInit(int min_r, int max_r, int min_c, int max_c) const {
     int numOfRows = max_r - min_r + 1;
     int numOfCols = max_c - min_c + 1;
     size_t buffSize = numOfRows * (2 * numOfCols + 1);
@@ -453,15 +432,72 @@ vector<char> MatFileHandler::bufferInit(int min_r, int max_r, int min_c, int max
     return buffer;
 }
 
-//write random-matrix file 
-void MatFileHandler::fWriteRndMat(int rows, int cols) {                         
-    if (!isValidMatSpec(rows, cols))
+bool MatFileHandler::writeRndMat(const string &filepath, int rows, int cols,
+                                 uint64_t matSeed, int rowThreads) const {
+    if (mccb) {
+        const auto buffer = mccbSerialize(genRndMat(rows, cols, matSeed, rowThreads), mccbEncoding);
+        return fWriteBuffer(filepath, buffer.data(), buffer.size());
+    }
+    if (fCompression(filepath) != Compression::NONE) {
+        const auto buffer = fillBuffRndMat(rows, cols, matSeed, rowThreads);
+        return fWriteBuffer(filepath, buffer.data(), buffer.size());
+    }
+
+    ofstream file(filepath, ios::out | ios::binary);
+    if (!file.is_open()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext(filepath));
+        return false;
+    }
+    const size_t rowSize = 2 * static_cast<size_t>(cols) + 1;
+    const int chunkRows = static_cast<int>(clamp<size_t>(GEN_CHUNK_BYTES / rowSize, 1, rows));
+    vector<char> chunk(chunkRows * rowSize);
+    for (int firstRow = 0; firstRow < rows && file; firstRow += chunkRows) {
+        const int lastRow = min(rows, firstRow + chunkRows);
+        fillRndRows(chunk.data(), firstRow, lastRow, cols, matSeed, rowThreads);
+        file.write(chunk.data(), static_cast<streamsize>((lastRow - firstRow) * rowSize));
+    }
+    file.close();
+    return !file.fail();
+}
+
+void MatFileHandler::genRndMatFiles(const vector<pair<int, int>> &sizes) {
+    struct GenJob {
+        string filepath;
+        int rows, cols;
+        uint64_t matSeed;
+    };
+
+    // announce (& filter) the files on this thread, in order
+    vector<GenJob> jobs;
+    for (const auto &[rows, cols] : sizes) {
+        if (!isValidMatSpec(rows, cols))
+            continue;
+        const string filepath = updatePath(rows, cols, min_v, max_v);
+        ostringstream info;
+        info << "Matrix File (" << rows << "x" << cols << ")";
+        if (fHandleInfo(filepath, info.str(), overwrite))
+            jobs.push_back({ filepath, rows, cols, rndMatSeed(rows, cols) });
+    }
+    if (jobs.empty())
         return;
-    const string filepath = updatePath(rows, cols, min_v, max_v);
-    ostringstream info;
-    info << "Matrix File (" << rows << "x" << cols << ")";
-    auto buffer = fillBuffRndMat(rows, cols);
-    fWrite(buffer, filepath, info.str(), overwrite);
+
+    // spare threads (fewer files than threads) draw rows within the files
+    const int numOfWorkers = max(1, min(threads, static_cast<int>(jobs.size())));
+    const int rowThreads = max(1, threads / numOfWorkers);
+    atomic<size_t> nextJob(0);
+
+    auto writeFiles = [&]() {
+        for (size_t job = nextJob++; job < jobs.size(); job = nextJob++)
+            writeRndMat(jobs[job].filepath, jobs[job].rows, jobs[job].cols, jobs[job].matSeed, rowThreads);
+    };
+
+    vector<thread> workers;
+    workers.reserve(numOfWorkers - 1);
+    for (int worker = 1; worker < numOfWorkers; worker++)
+        workers.emplace_back(writeFiles);
+    writeFiles();
+    for (auto &worker : workers)
+        worker.join();
 }
 
 //write matrix -> buffer -> file
@@ -473,7 +509,7 @@ void MatFileHandler::fWriteMat(const string &filename, bool skipUpdate) {
     string filepath = filename;
     if (!skipUpdate)
         filepath = updatePath(filename);
-    auto buffer = fillBuffMat();
+    auto buffer = isMccbFile(filepath) ? mccbSerialize(currMat, mccbEncoding) : fillBuffMat();
     fWrite(buffer, filepath, DEFAULT_INFO, overwrite);
 }
 
@@ -485,11 +521,13 @@ void MatFileHandler::genMatFiles() {
         if (skipAction("files generation"))
             return;
     }
+    vector<pair<int, int>> sizes;
     for (int rows = min_rows; rows <= max_rows; rows += row_inc) {
         for (int cols = min_cols; cols <= max_cols; cols += col_inc) {
-            fWriteRndMat(rows, cols);
+            sizes.emplace_back(rows, cols);
         }
     }
+    genRndMatFiles(sizes);
 }
 
 //Generate N x N square matrix files 
@@ -501,8 +539,10 @@ void MatFileHandler::genSqMatFiles() {
         if (skipAction("files generation"))
             return;
     }
+    vector<pair<int, int>> sizes;
     for (int rows = min_rows; rows <= max_rows; rows += row_inc)
-        fWriteRndMat(rows, rows);
+        sizes.emplace_back(rows, rows);
+    genRndMatFiles(sizes);
 }
 
 void MatFileHandler::invokeGenMatFiles() {
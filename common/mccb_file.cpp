@@ -0,0 +1,422 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MCCA_SSE2
+#endif
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+
+#include "headers/mccb_file.hpp"
+#include "headers/mapped_file.hpp"
+#include "headers/common.hpp"
+
+using namespace MyCommon;
+
+namespace {
+
+// Header field offsets
+constexpr size_t OFF_VERSION = 4;
+constexpr size_t OFF_ENCODING = 6;
+constexpr size_t OFF_BORDER = 7;
+constexpr size_t OFF_ROWS = 8;
+constexpr size_t OFF_COLS = 12;
+constexpr size_t OFF_MINV = 16;
+constexpr size_t OFF_MAXV = 17;
+constexpr size_t OFF_PAYLOAD_SIZE = 24;
+constexpr size_t OFF_CHECKSUM = 32;
+
+template <typename T>
+void putLE(char *dst, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i)
+        dst[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+}
+
+template <typename T>
+T getLE(const char *src) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        value |= static_cast<uint64_t>(static_cast<uint8_t>(src[i])) << (8 * i);
+    return static_cast<T>(value);
+}
+
+size_t packedRowBytes(int cols) {
+    return (static_cast<size_t>(cols) + 1) / 2;
+}
+
+struct MccbHeader {
+    MccbEncoding encoding;
+    int border;
+    int rows;
+    int cols;
+    int minVal;
+    int maxVal;
+    uint64_t payloadSize;
+    uint64_t checksum;
+};
+
+// Parse & cross-check the header against the file size; reason is set on failure
+bool parseHeader(const char *data, size_t size, MccbHeader &header, string &reason) {
+    if (size < MCCB_HEADER_SIZE || memcmp(data, MCCB_MAGIC, 4) != 0) {
+        reason = "bad magic";
+        return false;
+    }
+    if (getLE<uint16_t>(data + OFF_VERSION) != MCCB_VERSION) {
+        reason = "unsupported version";
+        return false;
+    }
+    const uint8_t encoding = getLE<uint8_t>(data + OFF_ENCODING);
+    if (encoding > static_cast<uint8_t>(MccbEncoding::PACKED4)) {
+        reason = "unknown cell encoding";
+        return false;
+    }
+    header.encoding = static_cast<MccbEncoding>(encoding);
+    header.border = getLE<uint8_t>(data + OFF_BORDER);
+
+    const uint32_t rows = getLE<uint32_t>(data + OFF_ROWS);
+    const uint32_t cols = getLE<uint32_t>(data + OFF_COLS);
+    const uint32_t dimMax = static_cast<uint32_t>(INT_MAX / 2 - header.border);
+    if (rows == 0 || cols == 0 || rows > dimMax || cols > dimMax) {
+        reason = "invalid dimensions";
+        return false;
+    }
+    header.rows = static_cast<int>(rows);
+    header.cols = static_cast<int>(cols);
+
+    header.minVal = getLE<uint8_t>(data + OFF_MINV);
+    header.maxVal = getLE<uint8_t>(data + OFF_MAXV);
+    if (header.minVal < MIN_VAL || header.maxVal > MAX_VAL || header.minVal > header.maxVal) {
+        reason = "value range out of " + withinRange(MIN_VAL, MAX_VAL);
+        return false;
+    }
+
+    header.payloadSize = getLE<uint64_t>(data + OFF_PAYLOAD_SIZE);
+    header.checksum = getLE<uint64_t>(data + OFF_CHECKSUM);
+
+    const uint64_t expected = header.encoding == MccbEncoding::RAW8
+        ? static_cast<uint64_t>(rows + 2 * header.border) * (cols + 2 * header.border)
+        : static_cast<uint64_t>(rows) * packedRowBytes(header.cols);
+    if (header.payloadSize != expected || size - MCCB_HEADER_SIZE != expected) {
+        reason = "payload size mismatch";
+        return false;
+    }
+    return true;
+}
+
+void decodePacked4Row(const uint8_t *src, int cols, Cell *dst) {
+    for (int c = 0; c + 1 < cols; c += 2) {
+        dst[c] = src[c / 2] & 0x0F;
+        dst[c + 1] = src[c / 2] >> 4;
+    }
+    if (cols & 1)
+        dst[cols - 1] = src[cols / 2] & 0x0F;
+}
+
+Grid decodePacked4(const uint8_t *payload, int rows, int cols) {
+    Grid matrix(rows, cols);
+    const size_t rowBytes = packedRowBytes(cols);
+    for (int r = 0; r < rows; ++r)
+        decodePacked4Row(payload + r * rowBytes, cols, matrix.row(r));
+    return matrix;
+}
+
+// Min & max byte of [data, data + size), size > 0
+pair<uint8_t, uint8_t> spanMinMax(const uint8_t *data, size_t size) {
+    uint8_t lo = data[0], hi = data[0];
+    size_t i = 0;
+#if defined(__AVX2__)
+    if (size >= 32) {
+        __m256i vlo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data)), vhi = vlo;
+        for (i = 32; i + 32 <= size; i += 32) {
+            const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+            vlo = _mm256_min_epu8(vlo, v);
+            vhi = _mm256_max_epu8(vhi, v);
+        }
+        alignas(32) uint8_t los[32], his[32];
+        _mm256_store_si256(reinterpret_cast<__m256i *>(los), vlo);
+        _mm256_store_si256(reinterpret_cast<__m256i *>(his), vhi);
+        lo = *min_element(los, los + 32);
+        hi = *max_element(his, his + 32);
+    }
+#elif defined(MCCA_SSE2)
+    if (size >= 16) {
+        __m128i vlo = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data)), vhi = vlo;
+        for (i = 16; i + 16 <= size; i += 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+            vlo = _mm_min_epu8(vlo, v);
+            vhi = _mm_max_epu8(vhi, v);
+        }
+        alignas(16) uint8_t los[16], his[16];
+        _mm_store_si128(reinterpret_cast<__m128i *>(los), vlo);
+        _mm_store_si128(reinterpret_cast<__m128i *>(his), vhi);
+        lo = *min_element(los, los + 16);
+        hi = *max_element(his, his + 16);
+    }
+#endif
+    for (; i < size; ++i) {
+        lo = min(lo, data[i]);
+        hi = max(hi, data[i]);
+    }
+    return { lo, hi };
+}
+
+// The engines trust a loaded grid (no bounds checks inside the sentinel border), which the checksum
+// alone doesn't warrant: every cell must lie within the header range (itself within [MIN_VAL, MAX_VAL]),
+// both its ends must be reached & every border byte must be SENTINEL. One min/max pass per row.
+
+// Row r's cells: within [minVal, maxVal] of the header, folded into the running minVal/maxVal
+bool checkRowCells(const Cell *row, int r, int cols, int headerMin, int headerMax,
+                   int &minVal, int &maxVal, string &reason) {
+    const auto [lo, hi] = spanMinMax(row, static_cast<size_t>(cols));
+    if (lo < headerMin || hi > headerMax) {
+        const int c = static_cast<int>(find_if(row, row + cols, [&](Cell cell) {
+            return cell < headerMin || cell > headerMax;
+        }) - row);
+        reason = "cell value " + to_string(row[c]) + " at row " + to_string(r) + ", col " + to_string(c) +
+                 " not " + withinRange(headerMin, headerMax);
+        return false;
+    }
+    minVal = min(minVal, static_cast<int>(lo));
+    maxVal = max(maxVal, static_cast<int>(hi));
+    return true;
+}
+
+// Border bytes [from, to) of a padded payload
+bool checkBorder(const uint8_t *data, size_t from, size_t to) {
+    return to <= from || spanMinMax(data + from, to - from).second == SENTINEL;
+}
+
+// Once all the rows are checked: the header range must be the cells' actual one
+bool checkValueRange(int headerMin, int headerMax, int minVal, int maxVal, string &reason) {
+    if (minVal != headerMin || maxVal != headerMax) {
+        reason = "header min/max values " + to_string(headerMin) + "/" + to_string(headerMax) +
+                 " don't match the cells' " + to_string(minVal) + "/" + to_string(maxVal);
+        return false;
+    }
+    return true;
+}
+
+// Whole grid: the border bytes between consecutive rows are contiguous. reason is set on failure.
+bool validateCells(const Grid &matrix, const MccbHeader &header, string &reason) {
+    const uint8_t *data = matrix.data();
+    int minVal = MAX_VAL + 1, maxVal = MIN_VAL - 1;
+
+    size_t gapStart = 0;  // first border byte not checked yet
+    for (int r = 0; r < matrix.rows(); ++r) {
+        const Cell *row = matrix.row(r);
+        const size_t rowStart = static_cast<size_t>(row - data);
+        if (!checkBorder(data, gapStart, rowStart)) {
+            reason = "non-sentinel border near row " + to_string(r);
+            return false;
+        }
+        if (!checkRowCells(row, r, matrix.cols(), header.minVal, header.maxVal, minVal, maxVal, reason))
+            return false;
+        gapStart = rowStart + matrix.cols();
+    }
+    if (!checkBorder(data, gapStart, matrix.paddedSize())) {
+        reason = "non-sentinel border after the last row";
+        return false;
+    }
+    return checkValueRange(header.minVal, header.maxVal, minVal, maxVal, reason);
+}
+
+// Header & payload checksum of a mapped file
+bool checkFile(const MappedFile &mapped, MccbHeader &header, string &reason) {
+    if (!parseHeader(mapped.data(), mapped.size(), header, reason))
+        return false;
+    const auto *payload = reinterpret_cast<const uint8_t *>(mapped.data() + MCCB_HEADER_SIZE);
+    if (mccbChecksum(payload, header.payloadSize) != header.checksum) {
+        reason = "checksum mismatch";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace
+
+uint64_t mccbChecksum(const uint8_t *data, size_t size) {
+    uint64_t sumA = 0;
+    uint64_t sumB = 0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        sumA += word;
+        sumB += sumA;
+    }
+    if (i < size) {
+        uint64_t word = 0;
+        memcpy(&word, data + i, size - i);
+        sumA += word;
+        sumB += sumA;
+    }
+    return sumB ^ ((sumA << 32) | (sumA >> 32));
+}
+
+bool isMccbFile(const string &filepath) {
+    return filesystem::path(filepath).extension() == ".mccb";
+}
+
+vector<char> mccbSerialize(const Grid &matrix, MccbEncoding encoding) {
+    const int rows = matrix.rows();
+    const int cols = matrix.cols();
+    if (matrix.empty())
+        return {};
+
+    int minVal = MAX_VAL;
+    int maxVal = MIN_VAL;
+    for (int r = 0; r < rows; ++r) {
+        const Cell *row = matrix.row(r);
+        for (int c = 0; c < cols; ++c) {
+            minVal = min(minVal, static_cast<int>(row[c]));
+            maxVal = max(maxVal, static_cast<int>(row[c]));
+        }
+    }
+
+    vector<char> buffer(MCCB_HEADER_SIZE);
+    uint8_t border = 0;
+
+    if (encoding == MccbEncoding::RAW8) {
+        // Store the padded layout as is, so that loading needs no copy
+        border = static_cast<uint8_t>(matrix.border());
+        const char *cells = reinterpret_cast<const char *>(matrix.data());
+        buffer.insert(buffer.end(), cells, cells + matrix.paddedSize());
+    }
+    else {
+        const size_t rowBytes = packedRowBytes(cols);
+        buffer.resize(MCCB_HEADER_SIZE + rows * rowBytes);
+        char *dst = buffer.data() + MCCB_HEADER_SIZE;
+        for (int r = 0; r < rows; ++r, dst += rowBytes) {
+            const Cell *row = matrix.row(r);
+            for (int c = 0; c < cols; ++c)
+                dst[c / 2] |= static_cast<char>((c & 1) ? row[c] << 4 : row[c]);
+        }
+    }
+
+    const uint64_t payloadSize = buffer.size() - MCCB_HEADER_SIZE;
+    const auto *payload = reinterpret_cast<const uint8_t *>(buffer.data() + MCCB_HEADER_SIZE);
+
+    char *header = buffer.data();
+    memcpy(header, MCCB_MAGIC, 4);
+    putLE<uint16_t>(header + OFF_VERSION, MCCB_VERSION);
+    putLE<uint8_t>(header + OFF_ENCODING, static_cast<uint8_t>(encoding));
+    putLE<uint8_t>(header + OFF_BORDER, border);
+    putLE<uint32_t>(header + OFF_ROWS, rows);
+    putLE<uint32_t>(header + OFF_COLS, cols);
+    putLE<uint8_t>(header + OFF_MINV, minVal);
+    putLE<uint8_t>(header + OFF_MAXV, maxVal);
+    putLE<uint64_t>(header + OFF_PAYLOAD_SIZE, payloadSize);
+    putLE<uint64_t>(header + OFF_CHECKSUM, mccbChecksum(payload, payloadSize));
+    return buffer;
+}
+
+bool mccbLoad(const string &filepath, Grid &matrix, bool report) {
+    // Copy-on-write: the engines may write into the grid, never into the file
+    auto mapped = make_shared<MappedFile>(filepath, true);
+    if (!mapped->isOpen()) {
+        if (report)
+            handleError(ErrCode::FILE_OPEN_ERROR, filepath);
+        return false;
+    }
+
+    MccbHeader header;
+    string reason;
+    if (!checkFile(*mapped, header, reason)) {
+        if (report)
+            handleError(ErrCode::INVALID_MCCB, reason, filepath);
+        return false;
+    }
+
+    auto *payload = reinterpret_cast<uint8_t *>(mapped->writableData() + MCCB_HEADER_SIZE);
+
+    Grid loaded = (header.encoding == MccbEncoding::PACKED4)
+        ? decodePacked4(payload, header.rows, header.cols)
+        : Grid(payload, header.rows, header.cols, header.border, std::move(mapped));
+    if (!validateCells(loaded, header, reason)) {
+        if (report)
+            handleError(ErrCode::INVALID_MCCB, reason, filepath);
+        return false;
+    }
+    matrix = std::move(loaded);
+    return true;
+}
+
+MccbRowReader::MccbRowReader(const string &filepath) : mapped(filepath), filepath(filepath) {
+    if (!mapped.isOpen()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, filepath);
+        error = true;
+        return;
+    }
+    MccbHeader header;
+    string reason;
+    if (!checkFile(mapped, header, reason)) {
+        handleError(ErrCode::INVALID_MCCB, reason, filepath);
+        error = true;
+        return;
+    }
+    packed = header.encoding == MccbEncoding::PACKED4;
+    border = header.border;
+    numOfRows = header.rows;
+    numOfCols = header.cols;
+    headerMin = header.minVal;
+    headerMax = header.maxVal;
+    payload = reinterpret_cast<const uint8_t *>(mapped.data() + MCCB_HEADER_SIZE);
+    rowStride = packed ? packedRowBytes(numOfCols) : static_cast<size_t>(numOfCols) + 2 * border;
+}
+
+bool MccbRowReader::nextRow(vector<Cell> &row) {
+    if (error || rowCnt == numOfRows)
+        return false;
+
+    string reason;
+    row.resize(numOfCols);
+    if (packed)
+        decodePacked4Row(payload + rowCnt * rowStride, numOfCols, row.data());
+    else {
+        const size_t rowStart = (rowCnt + border) * rowStride + border;
+        if (!checkBorder(payload, gapStart, rowStart)) {
+            reason = "non-sentinel border near row " + to_string(rowCnt);
+            return fail(reason);
+        }
+        copy(payload + rowStart, payload + rowStart + numOfCols, row.begin());
+        gapStart = rowStart + numOfCols;
+    }
+    if (!checkRowCells(row.data(), rowCnt, numOfCols, headerMin, headerMax, minVal, maxVal, reason))
+        return fail(reason);
+
+    if (++rowCnt == numOfRows) {
+        if (!packed && !checkBorder(payload, gapStart, (numOfRows + 2 * border) * rowStride))
+            return fail("non-sentinel border after the last row");
+        if (!checkValueRange(headerMin, headerMax, minVal, maxVal, reason))
+            return fail(reason);
+    }
+    return true;
+}
+
+bool MccbRowReader::fail(const string &reason) {
+    handleError(ErrCode::INVALID_MCCB, reason, filepath);
+    error = true;
+    return false;
+}
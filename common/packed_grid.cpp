@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#include <algorithm>
+
+#include "headers/packed_grid.hpp"
+
+PackedGrid::PackedGrid() :
+    nRows(0), nCols(0), rowWords(0), lastMask(0), minV(MIN_VAL), maxV(MIN_VAL) {}
+
+PackedGrid::PackedGrid(const Grid &mat) :
+    nRows(mat.rows()), nCols(mat.cols()),
+    rowWords((mat.cols() + CELLS_PER_WORD - 1) / CELLS_PER_WORD),
+    minV(MAX_VAL), maxV(MIN_VAL) {
+
+    const int tail = nCols % CELLS_PER_WORD;
+    lastMask = tail ? NIBBLE_LSB >> (4 * (CELLS_PER_WORD - tail)) : NIBBLE_LSB;
+
+    words.assign(static_cast<size_t>(nRows + 2) * rowWords, 0);
+    for (int r = 0; r < nRows; ++r) {
+        const Cell *src = mat.row(r);
+        uint64_t *dst = words.data() + static_cast<size_t>(r + 1) * rowWords;
+        for (int c = 0; c < nCols; ++c) {
+            dst[c / CELLS_PER_WORD] |= static_cast<uint64_t>(src[c]) << (4 * (c % CELLS_PER_WORD));
+            minV = min(minV, static_cast<int>(src[c]));
+            maxV = max(maxV, static_cast<int>(src[c]));
+        }
+    }
+}
+
+Grid PackedGrid::unpack() const {
+    Grid mat(nRows, nCols);
+    for (int r = 0; r < nRows; ++r)
+        unpackRow(r, mat.row(r));
+    return mat;
+}
+
+void PackedGrid::unpackRow(int r, Cell *dst) const {
+    const uint64_t *src = row(r);
+    for (int c = 0; c < nCols; ++c)
+        dst[c] = static_cast<Cell>((src[c / CELLS_PER_WORD] >> (4 * (c % CELLS_PER_WORD))) & 0xF);
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MCCA_SSE2
+#endif
+
+#include "headers/row_serializer.hpp"
+
+char *serializeRow(const Cell *cells, const uint8_t *mask, int cols, char delimiter, char *out) {
+    int c = 0;
+
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i digitBase = _mm256_set1_epi8('0');
+    const __m256i delim = _mm256_set1_epi8(delimiter);
+    for (; c + 32 <= cols; c += 32) {
+        const __m256i digits = _mm256_add_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(cells + c)), digitBase);
+        const __m256i blank = _mm256_cmpeq_epi8(
+            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(mask + c)), zero);
+        const __m256i chars = _mm256_blendv_epi8(digits, delim, blank);
+        // unpack works within 128-bit lanes: lo = cells 0-7 | 16-23, hi = cells 8-15 | 24-31
+        const __m256i lo = _mm256_unpacklo_epi8(chars, delim);
+        const __m256i hi = _mm256_unpackhi_epi8(chars, delim);
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * c), _mm256_permute2x128_si256(lo, hi, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + 2 * c + 32), _mm256_permute2x128_si256(lo, hi, 0x31));
+    }
+#elif defined(MCCA_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i digitBase = _mm_set1_epi8('0');
+    const __m128i delim = _mm_set1_epi8(delimiter);
+    for (; c + 16 <= cols; c += 16) {
+        const __m128i digits = _mm_add_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(cells + c)), digitBase);
+        const __m128i blank = _mm_cmpeq_epi8(
+            _mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + c)), zero);
+        const __m128i chars = _mm_or_si128(_mm_andnot_si128(blank, digits), _mm_and_si128(blank, delim));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * c), _mm_unpacklo_epi8(chars, delim));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + 2 * c + 16), _mm_unpackhi_epi8(chars, delim));
+    }
+#endif
+
+    for (; c < cols; ++c) {
+        out[2 * c] = mask[c] ? static_cast<char>('0' + cells[c]) : delimiter;
+        out[2 * c + 1] = delimiter;
+    }
+
+    // The delimiter after the last cell becomes the CRLF
+    out[2 * cols - 1] = '\r';
+    out[2 * cols] = '\n';
+    return out + 2 * cols + 1;
+}
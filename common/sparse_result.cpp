@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#include <charconv>
+#include <cstring>
+
+#include "headers/sparse_result.hpp"
+
+namespace {
+
+// Header field offsets
+constexpr size_t OFF_VERSION = 4;
+constexpr size_t OFF_ROWS = 8;
+constexpr size_t OFF_COLS = 12;
+constexpr size_t OFF_ORIGIN_ROW = 16;
+constexpr size_t OFF_ORIGIN_COL = 20;
+constexpr size_t OFF_CELLS = 24;
+
+template <typename T>
+void putLE(char *dst, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i)
+        dst[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+}
+
+void appendInt(vector<char> &out, int value) {
+    char digits[16];
+    out.insert(out.end(), digits, to_chars(digits, digits + sizeof(digits), value).ptr);
+}
+
+// Next selected (value 1) or unselected (value 0) column in [col, end), end if none
+int findMask(const uint8_t *mask, int col, int end, uint8_t value) {
+    const void *hit = memchr(mask + col, value, static_cast<size_t>(end - col));
+    return hit ? static_cast<int>(static_cast<const uint8_t *>(hit) - mask) : end;
+}
+
+vector<char> encodeMask(int firstRow, int rows, int firstCol, int cols,
+                        vector<uint8_t> &mask, const RowMaskFunc &rowMask) {
+    const size_t rowBytes = (static_cast<size_t>(cols) + 7) / 8;
+    vector<char> out(MCCM_HEADER_SIZE + rowBytes * rows, 0);
+    uint64_t cells = 0;
+    for (int r = 0; r < rows; r++) {
+        rowMask(firstRow + r, mask.data());
+        char *bits = out.data() + MCCM_HEADER_SIZE + rowBytes * r;
+        const uint8_t *window = mask.data() + firstCol;
+        for (int c = findMask(window, 0, cols, 1); c < cols; c = findMask(window, c + 1, cols, 1)) {
+            bits[c >> 3] |= static_cast<char>(1 << (c & 7));
+            cells++;
+        }
+    }
+    memcpy(out.data(), MCCM_MAGIC, 4);
+    putLE<uint16_t>(out.data() + OFF_VERSION, MCCM_VERSION);
+    putLE<uint32_t>(out.data() + OFF_ROWS, rows);
+    putLE<uint32_t>(out.data() + OFF_COLS, cols);
+    putLE<uint32_t>(out.data() + OFF_ORIGIN_ROW, firstRow);
+    putLE<uint32_t>(out.data() + OFF_ORIGIN_COL, firstCol);
+    putLE<uint64_t>(out.data() + OFF_CELLS, cells);
+    return out;
+}
+
+}
+
+vector<char> encodeSparse(const string &format,
+                          int firstRow, int rows,
+                          int firstCol, int cols,
+                          int maskWidth,
+                          const RowMaskFunc &rowMask) {
+    vector<uint8_t> mask(maskWidth);
+    if (format == "mask")
+        return encodeMask(firstRow, rows, firstCol, cols, mask, rowMask);
+
+    const bool runs = format == "runs";
+    const int endCol = firstCol + cols;
+    vector<char> body;
+    uint64_t cells = 0;
+    for (int row = firstRow; row < firstRow + rows; row++) {
+        rowMask(row, mask.data());
+        int first = findMask(mask.data(), firstCol, endCol, 1);
+        if (runs && first < endCol)
+            appendInt(body, row);
+        while (first < endCol) {
+            const int end = findMask(mask.data(), first + 1, endCol, 0);
+            cells += end - first;
+            if (runs) {
+                body.push_back(' ');
+                appendInt(body, first);
+                body.push_back('-');
+                appendInt(body, end - 1);
+            }
+            else {
+                for (int col = first; col < end; col++) {
+                    appendInt(body, row);
+                    body.push_back(' ');
+                    appendInt(body, col);
+                    body.push_back('\n');
+                }
+            }
+            first = findMask(mask.data(), end, endCol, 1);
+        }
+        if (runs && !body.empty() && body.back() != '\n')
+            body.push_back('\n');
+    }
+
+    const string header = "# " + format + " rows=" + to_string(rows) + " cols=" + to_string(cols) +
+                          " origin=(" + to_string(firstRow) + "," + to_string(firstCol) + ")" +
+                          " cells=" + to_string(cells) + "\n";
+    vector<char> out;
+    out.reserve(header.size() + body.size());
+    out.insert(out.end(), header.begin(), header.end());
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+string sparseExt(const string &format) {
+    return (format == "mask") ? ".mccm" : ".txt";
+}
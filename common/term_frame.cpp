@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#include <charconv>
+#include <iostream>
+
+#ifndef _WIN32
+    #include <unistd.h>
+#endif
+
+#include "headers/common.hpp"
+#include "headers/term_frame.hpp"
+
+TermFrame::~TermFrame() {
+    flush();
+}
+
+#ifdef _WIN32
+
+void TermFrame::color(unsigned short colorCode) {
+    if (colorCode == currColor)
+        return;
+    currColor = colorCode;
+    colored = true;
+    runs.emplace_back(text.size(), colorCode);
+}
+
+void TermFrame::flush() {
+    if (text.empty())
+        return;
+    cout.flush();
+    size_t begin = 0;
+    unsigned short runColor = DEFAULT_COLOR;
+    for (const auto &[offset, colorCode] : runs) {
+        SetConsoleTextAttribute(MyCommon::handle, runColor);
+        cout.write(text.data() + begin, static_cast<streamsize>(offset - begin)).flush();
+        begin = offset;
+        runColor = colorCode;
+    }
+    SetConsoleTextAttribute(MyCommon::handle, runColor);
+    cout.write(text.data() + begin, static_cast<streamsize>(text.size() - begin)).flush();
+    if (colored)
+        MyCommon::resetConsoleColor();
+    text.clear();
+    runs.clear();
+    currColor = DEFAULT_COLOR;
+    colored = false;
+}
+
+#else
+
+void TermFrame::color(unsigned short colorCode) {
+    if (colorCode == currColor && colored)
+        return;
+    currColor = colorCode;
+    colored = true;
+    char code[8];
+    const auto end = to_chars(code, code + sizeof(code), colorCode).ptr;
+    text += "\033[";
+    text.append(code, end);
+    text += 'm';
+}
+
+void TermFrame::flush() {
+    if (text.empty())
+        return;
+    if (colored)
+        text += "\033[0m";
+    cout.flush();  // keep the order of anything printed before
+    const char *data = text.data();
+    size_t left = text.size();
+    while (left > 0) {
+        const ssize_t written = ::write(STDOUT_FILENO, data, left);
+        if (written <= 0)
+            break;
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+    text.clear();
+    currColor = DEFAULT_COLOR;
+    colored = false;
+}
+
+#endif
@@ -23,9 +23,17 @@ void mainMenuDisplay() {
     title_and_ver();
     formatTxt("Main App:", LIGHT_CYAN);
     cout << "Usage: MCCA [--help] [/?] [--ver] [--cond] [--paint] [--no_color] [--crop] [--visualizer <image_format>]\n"
-        << "            [--root_dir <rootDir>] [--algo <algo>] [--matrix <matString>]\n"
+        << "            [--vis_mode <mode>] [--root_dir <rootDir>] [--algo <algo>] [--uf_policy <policy>] [--threads <N>]\n"
+        << "            [--regions <format>] [--stream] [--queue_depth <N>] [--packed] [--matrix <matString>] [--mccb]\n"
+        << "            [--compress <format>] [--image <format>] [--false_color] [--result_format <format>]\n"
         << "Options:\n"
-        << "  --algo       : Select graph algorithm: DFS, UF or BOTH.\n"
+        << "  --algo       : Select graph algorithm: DFS, UF, CCL (two-pass labeling), RUN (run-based labeling)\n"
+        << "                 or BOTH (DFS & UF).\n"
+        << "  --uf_policy  : UnionFind find/union policy: " << UF_POLICIES << " (default: " << DEFAULT_UF_POLICY << ").\n"
+        << "  --threads    : UF worker threads (strip-parallel labeling), 1 <= N <= " << THREADS_MAX << " (default: " << DEFAULT_THREADS << ").\n"
+        << "                 Results are identical for any N.\n"
+        << "  --regions    : Dump per-region statistics (size, color, bbox, centroid, boundary cells)\n"
+        << "                 under root_dir. format: " << REGIONS_FORMATS << ".\n"
         << "  --paint      : Paint max connected color regions.\n"
         << "  --no_color   : Paint black and white (using unique symbols).\n"
         << "                 If neiter paint nor no_color arg is used, then results will be saved under root_dir.\n"
@@ -33,11 +41,30 @@ void mainMenuDisplay() {
         << "  --matrix     : Specify matrices (C/C++ format) as a string, e.g.\n"
         << "                 --matrix \"" << MATSTR << "\"\n"
         << "                 Values allowed: integers " << withinRange(MIN_VAL, MAX_VAL) << ".\n"
+        << "  --mccb       : Save the --matrix inputs as .mccb binary files (otherwise: txt).\n"
         << "  --visualizer : UnionFind Root visualizer. Limited by design choice to "
         << "small matrices with max(rows, cols) <= " << VIS_MAT_THR << ").\n"
         << "                 Graphviz must be installed and added to System Env. Path.\n"
         << "                 image_format:" << VIS_IMAGE_FORMATS << ".\n"
-        << "  --crop       : Save max regions (inc. their original coordinates) into files. Ignored if painting is used.\n";
+        << "  --vis_mode   : Visualizer graph: " << VIS_MODES << " (default: " << DEFAULT_VIS_MODE << ").\n"
+        << "                 condensed: one node per region (sized by cell count, filled with its color)\n"
+        << "                 & one edge per adjacent pair of regions, for any matrix size.\n"
+        << "  --stream     : Label matrix files row by row, keeping only two rows in memory (for matrices larger than RAM).\n"
+        << "                 Reports max size, color & bounding box; --algo, --paint & --crop are ignored.\n"
+        << "  --queue_depth: Matrix files are parsed ahead of the solver, at most N waiting at a time,\n"
+        << "                 1 <= N <= " << QUEUE_DEPTH_MAX << " (default: " << DEFAULT_QUEUE_DEPTH << ").\n"
+        << "  --packed     : Keep queued matrix files nibble-packed (4 bits per cell, half the memory).\n"
+        << "                 UF labels them packed; DFS & CCL unpack one matrix at a time.\n"
+        << "  --crop       : Save max regions (inc. their original coordinates) into files. Ignored if painting is used.\n"
+        << "  --result_format: Max region result files: " << RESULT_FORMATS << " (default: " << DEFAULT_RESULT_FORMAT << ").\n"
+        << "                 dense: the full (or --crop) grid as text; runs: per-row column runs; coords: one line per cell;\n"
+        << "                 mask: 1-bit packed mask with a header (.mccm). Sparse files hold original coordinates.\n"
+        << "  --compress   : Compress the result files: " << COMPRESS_FORMATS << " (availability depends on the build).\n"
+        << "                 Compressed matrix files (e.g. mat.txt.gz) under root_dir are always read.\n"
+        << "  --image      : Save an image of each solved matrix (colored by value, max regions highlighted),\n"
+        << "                 written by MCCA itself: " << IMAGE_FORMATS << ". Ignored with --stream.\n"
+        << "  --false_color: Color the --image by region (one color per connected region).\n"
+        << "                 Not for DFS (disabled with a warning; with BOTH, only the UF image).\n";
     formatTxt("  --help or /? : Display this help menu.", LIGHT_MAGENTA);
     formatTxt("  --cond       : Display conditions.", LIGHT_MAGENTA);
     formatTxt("  --ver        : Display title and version.\n", LIGHT_MAGENTA);
@@ -45,7 +72,8 @@ void mainMenuDisplay() {
     formatTxt("Example: mcca --root_dir C:/MCCA/data/default_matrices --paint --algo dfs\n", LIGHT_GREEN);
     formatTxt("Example: mcca --root_dir ../data/multicolor --visualizer png --crop --algo both\n", LIGHT_GREEN);
     formatTxt("Matrix Files Generator:", LIGHT_CYAN);
-    cout << "Usage: mcca filegen [--square] [--confirm] [--ovr] [--root_dir <rootDir>] [--csv]\n"
+    cout << "Usage: mcca filegen [--square] [--confirm] [--ovr] [--root_dir <rootDir>] [--csv] [--mccb] [--mccb_packed]\n"
+        << "                    [--compress <format>] [--seed <seed>] [--threads <N>]\n"
         << "                    [--minrows <min_rows>] [--maxrows <max_rows>] [--row_inc <row_inc>]\n"
         << "                    [--mincols <min_cols>] [--maxcols <max_cols>] [--col_inc <col_inc>] \n"
         << "                    [--minv <min_v>][--maxv <max_v>]\n"
@@ -54,6 +82,12 @@ void mainMenuDisplay() {
         << "  --confirm           : Automatically confirm saving files to disk.\n"
         << "  --ovr               : Enable overwrite.\n"
         << "  --csv               : Save csv files (otherwise: txt, space-separated).\n"
+        << "  --mccb              : Save .mccb binary files (1 byte per cell, mapped as is when loaded).\n"
+        << "  --mccb_packed       : Save .mccb binary files, 2 cells per byte.\n"
+        << "  --compress <format> : Compress txt/csv files: " << COMPRESS_FORMATS << ".\n"
+        << "  --seed <seed>       : Reproducible matrices, 0 <= seed <= " << SEED_MAX << " (default: random).\n"
+        << "  --threads <N>       : Files & rows are generated in parallel, 1 <= N <= " << THREADS_MAX << ".\n"
+        << "                        Files are identical for any N.\n"
         << "  --minrows <min_rows>: min_rows <= " << ROWS_MAX << ".\n"
         << "  --maxrows <max_rows>: max_rows <= " << ROWS_MAX << ".\n"
         << "  --row_inc <row_inc> : row_inc <= " << INC_MAX << ".\n"
@@ -65,6 +99,14 @@ void mainMenuDisplay() {
     formatTxt("  Note: --square cannot be used with column parameters.\n", LIGHT_YELLOW);
     formatTxt("Examples: mcca filegen --maxrows 750 --maxcols 400 --inc_col 20\n", LIGHT_GREEN);
     formatTxt("          mcca filegen --square --minrows 4000 --maxrows 5000 --row_inc 500 --csv \n", LIGHT_GREEN);
+    formatTxt("Matrix Files Converter:", LIGHT_CYAN);
+    cout << "Usage: mcca convert --to <format> [--ovr] [--root_dir <rootDir>] [--mccb_packed] [--compress <format>]\n"
+        << "  --to <format>       : Convert the matrix files under root_dir to: " << CONVERT_FORMATS << ".\n"
+        << "                        Converted files are saved next to their sources.\n"
+        << "  --mccb_packed       : Pack .mccb files, 2 cells per byte.\n"
+        << "  --compress <format> : Compress txt/csv files: " << COMPRESS_FORMATS << " (e.g. --to txt --compress gz).\n";
+    formatTxt("  Note: a .mccb file shadows the txt/csv file of the same name when processing root_dir.\n", LIGHT_YELLOW);
+    formatTxt("Example: mcca convert --to mccb --root_dir ../data/multicolor\n", LIGHT_GREEN);
 }
 
 void handleArgs(int argc, char *argv[], 
@@ -73,7 +115,17 @@ void handleArgs(int argc, char *argv[],
                 MatFileHandler &mfh,
                 bool &paint, bool &colors,
                 bool &crop, 
-                pair<bool, string> &visConfig) {
+                pair<bool, string> &visConfig,
+                string &visMode,
+                string &ufPolicy,
+                int &threads,
+                string &regionsFormat,
+                string &rasterFormat,
+                bool &falseColor,
+                string &resultFormat,
+                bool &stream,
+                int &queueDepth,
+                bool &packed) {
 
     int min_rows = DEFAULT_MIN_R;
     int max_rows = DEFAULT_MAX_R;
@@ -85,6 +137,8 @@ void handleArgs(int argc, char *argv[],
     int max_v = DEFAULT_MAX_V;
 
     bool filegen = DEFAULT_FILEGEN;
+    bool convert = false;
+    string convertFormat;
   
     bool algoSpecified = IS_ALGO_SPECIFIED; 
     bool skip_algo_handler = SKIP_ALGO_HANDLER; 
@@ -94,17 +148,24 @@ void handleArgs(int argc, char *argv[],
 
     unordered_set<string> fg_col_param_flags = { "--mincols", "--maxcols", "--col_inc" }; 
 
-    unordered_set<string> param_flags = { "--algo", "--root_dir", "--matrix", "--visualizer",
-                                          "--minrows", "--maxrows", "--row_inc", 
-                                          "--minv", "--maxv"};
+    unordered_set<string> param_flags = { "--algo", "--uf_policy", "--threads", "--regions", "--queue_depth", "--root_dir", "--matrix", "--visualizer",
+                                          "--vis_mode", "--minrows", "--maxrows", "--row_inc", 
+                                          "--minv", "--maxv", "--to", "--compress", "--seed", "--image", "--result_format"};
 
     param_flags.insert(fg_col_param_flags.begin(), fg_col_param_flags.end());
                                 
     unordered_set<string> standalone_flags = { "--help", "/?", "--paint", "--no_color", "--csv",
-                                               "--crop", "filegen", "--cond",
-                                               "--square", "--confirm", "--ovr", "--ver"};
+                                               "--crop", "--stream", "filegen", "convert", "--cond",
+                                               "--square", "--confirm", "--ovr", "--ver",
+                                               "--mccb", "--mccb_packed", "--packed", "--false_color"};
 
     static const auto supportedImageFormats = split2UnorderedSet(VIS_IMAGE_FORMATS);
+    static const auto supportedRegionsFormats = split2UnorderedSet(REGIONS_FORMATS);
+    static const auto supportedVisModes = split2UnorderedSet(VIS_MODES);
+    static const auto supportedRasterFormats = split2UnorderedSet(IMAGE_FORMATS);
+    static const auto supportedResultFormats = split2UnorderedSet(RESULT_FORMATS);
+    static const auto supportedConvertFormats = split2UnorderedSet(CONVERT_FORMATS);
+    static const auto supportedCompressFormats = split2UnorderedSet(COMPRESS_FORMATS);
 
     // Parse the arguments and map them
     for (int i = 1; i < argc; ++i) {
@@ -166,6 +227,14 @@ void handleArgs(int argc, char *argv[],
             crop = true; 
         }
 
+        if (arg == "--stream") {
+            stream = true;
+        }
+
+        if (arg == "--packed") {
+            packed = true;
+        }
+
         if (arg == "--csv") { 
             mfh.txt = false;
         }
@@ -187,6 +256,75 @@ void handleArgs(int argc, char *argv[],
             algoSpecified = true;          
         }
 
+        if (arg == "--uf_policy") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            ufPolicy = strToUpper(value);
+            if (isInvalidUfPolicy(ufPolicy)) {
+                handleError(ErrCode::INVALID_UF_POLICY, ErrorContext());
+                cliErrHandler();
+            }
+        }
+
+        if (arg == "--threads") {
+            validateAndAssign(threads, arg, 1, THREADS_MAX, args_map);
+            mfh.threads = threads;
+        }
+
+        if (arg == "--seed") {
+            int seed = 0;
+            validateAndAssign(seed, arg, 0, SEED_MAX, args_map);
+            mfh.seed = static_cast<uint64_t>(seed);
+        }
+
+        if (arg == "--queue_depth") {
+            validateAndAssign(queueDepth, arg, 1, QUEUE_DEPTH_MAX, args_map);
+        }
+
+        if (arg == "--regions") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            regionsFormat = value;
+            ranges::transform(regionsFormat, regionsFormat.begin(), ::tolower);
+            if (!supportedRegionsFormats.contains(regionsFormat)) {
+                handleError(ErrCode::INVALID_REGIONS_FORMAT, ErrorContext());
+                cliErrHandler();
+            }
+        }
+
+        if (arg == "--image") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            rasterFormat = value;
+            ranges::transform(rasterFormat, rasterFormat.begin(), ::tolower);
+            if (!supportedRasterFormats.contains(rasterFormat)) {
+                handleError(ErrCode::INVALID_IMAGE_FORMAT, ErrorContext());
+                cliErrHandler();
+            }
+        }
+
+        if (arg == "--result_format") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            resultFormat = value;
+            ranges::transform(resultFormat, resultFormat.begin(), ::tolower);
+            if (!supportedResultFormats.contains(resultFormat)) {
+                handleError(ErrCode::INVALID_RESULT_FORMAT, ErrorContext());
+                cliErrHandler();
+            }
+        }
+
+        if (arg == "--false_color")
+            falseColor = true;
+
         if (arg == "--matrix") {
             if (value.empty()) {
                 handleError(ErrCode::MISSING_ARG_VALUE, arg);
@@ -218,11 +356,70 @@ void handleArgs(int argc, char *argv[],
             }
         }
 
+        if (arg == "--vis_mode") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            visMode = value;
+            ranges::transform(visMode, visMode.begin(), ::tolower);
+            if (!supportedVisModes.contains(visMode)) {
+                handleError(ErrCode::INVALID_VIS_MODE, ErrorContext());
+                cliErrHandler();
+            }
+        }
+
         if (arg == "filegen") {
             filegen = true;
             skip_algo_handler = true;
         }
 
+        if (arg == "convert") {
+            convert = true;
+            skip_algo_handler = true;
+        }
+
+        if (arg == "--to") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            convertFormat = value;
+            ranges::transform(convertFormat, convertFormat.begin(), ::tolower);
+            if (!supportedConvertFormats.contains(convertFormat)) {
+                handleError(ErrCode::INVALID_FILE_EXT, value);
+                cliErrHandler();
+            }
+        }
+
+        if (arg == "--compress") {
+            if (value.empty()) {
+                handleError(ErrCode::MISSING_ARG_VALUE, arg);
+                cliErrHandler();
+            }
+            string compressFormat = value;
+            ranges::transform(compressFormat, compressFormat.begin(), ::tolower);
+            if (!supportedCompressFormats.contains(compressFormat)) {
+                handleError(ErrCode::INVALID_COMPRESS_FORMAT, ErrorContext());
+                cliErrHandler();
+            }
+            mfh.compression = fCompression("." + compressFormat);
+            if (!isCompressionSupported(mfh.compression)) {
+                handleError(ErrCode::COMPRESSION_NA, compressFormat);
+                cliErrHandler();
+            }
+            mfh.writer.compression = mfh.compression;
+        }
+
+        if (arg == "--mccb") {
+            mfh.mccb = true;
+        }
+
+        if (arg == "--mccb_packed") {
+            mfh.mccb = true;
+            mfh.mccbEncoding = MccbEncoding::PACKED4;
+        }
+
         if (arg == "--square") {
             mfh.sqmat = true;
         }
@@ -316,6 +513,16 @@ void handleArgs(int argc, char *argv[],
         mfh.invokeGenMatFiles();
         exit(0);
     }
+
+    if (convert) {
+        if (convertFormat.empty()) {
+            handleError(ErrCode::MISSING_ARG_VALUE, string("--to"));
+            cliErrHandler();
+        }
+        formatTxt("Matrix Files Converter activated!", LIGHT_GREEN);
+        mfh.convertMatFiles(convertFormat);
+        exit(0);
+    }
 }
 
 void validateAndAssign(int &variable, const string &arg, int min_value, 
@@ -354,7 +561,7 @@ bool isFlag(const string &str) {
 }
 
 bool isInvalidAlgoChoice(const string &algoChoice) {
-    return (algoChoice != "DFS" && algoChoice != "UF" && algoChoice != "BOTH");
+    return (algoChoice != "DFS" && algoChoice != "UF" && algoChoice != "CCL" && algoChoice != "RUN" && algoChoice != "BOTH");
 }
 
 void handleAlgoSelection(string &algo, const string &value) {
@@ -382,6 +589,18 @@ void visualizerNotifier(const string &algo, bool &visEnable) {
     }
 }
 
+void falseColorNotifier(const string &algo, bool &falseColor) {
+    if (!falseColor)
+        return;
+    // DFS keeps only the max region mask, no per-cell regions to color by
+    if (algo == "DFS") {
+        formatTxt("Disabling --false_color since DFS keeps no per-region labels.\n", LIGHT_YELLOW);
+        falseColor = false;
+    }
+    else if (algo == "BOTH")
+        formatTxt("--false_color applies to the UF image only, the DFS image keeps value colors.\n", LIGHT_YELLOW);
+}
+
 void title_and_ver() {
     ostringstream info;
     info << TITLE << VERSION << COPYRIGHT;
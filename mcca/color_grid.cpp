@@ -17,21 +17,32 @@
  * The original author, Yaron Dayan, must be credited in all derivative works.
  */
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include "headers/color_grid.hpp"
 
 ColorGrid::ColorGrid(MatFileHandler &handler):
     mfh(handler), n(1), m(1), maxSize(1), maxColor(1),
-    minVal(INT_MAX), maxVal(INT_MIN), filename("") {}
+    minVal(INT_MAX), maxVal(INT_MIN), filename(""), resultFormat(DEFAULT_RESULT_FORMAT), falseColor(false) {}
 
-void ColorGrid::init(vector<vector<int>> &mat) {
-    n = static_cast<int>(mat.size());
-    m = static_cast<int>(mat[0].size());
+void ColorGrid::init(Grid &mat) {
+    if (mat.border() < GRID_BORDER)
+        mat = mat.withBorder(GRID_BORDER);
+    n = mat.rows();
+    m = mat.cols();
     maxColor = 1;
     maxSize = 1;
+    regions.clear();
 }
 
-bool ColorGrid::isValid(int row, int col, int n, int m) {
-    return (row >= 0 && row < n && col >= 0 && col < m);
+void ColorGrid::init(const PackedGrid &mat) {
+    n = mat.rows();
+    m = mat.cols();
+    maxColor = 1;
+    maxSize = 1;
+    regions.clear();
 }
 
 // update filename member 
@@ -75,25 +86,35 @@ int ColorGrid::alignCol(int &col) {
     return (col % 2) ? 2 * col + 1 : 2 * col;
 }
 
-void ColorGrid::paintResultsArea(vector<vector<int>> &matrix,
+void ColorGrid::paintResultsArea(const Grid &matrix,
                                  bool colors,
                                  function<bool(int, int)> cellCondition) const {
+    // the whole matrix is rendered as a single frame (flushed in TERM_FRAME_BYTES pieces if larger)
+    TermFrame frame;
     for (int r = 0; r < n; r++) {
+        const Cell *row = matrix.row(r);
         for (int c = 0; c < m; c++) {
-            int currValue = matrix[r][c];
-            string currValueStr = to_string(currValue);
+            const int currValue = row[c];
 
             if (cellCondition(r, c)) {
-                if (colors)
-                    formatTxt(currValueStr, getColorFromKey(currValue), " ");
-                else
-                    formatTxt(string(1, getSymbolFromKey(currValue)), DEFAULT_COLOR, " ");
+                if (colors) {
+                    frame.color(getColorFromKey(currValue));
+                    frame.append(itoc(currValue));
+                }
+                else {
+                    frame.color(DEFAULT_COLOR);
+                    frame.append(getSymbolFromKey(currValue));
+                }
             }
             else {
-                formatTxt(currValueStr, DEFAULT_COLOR, " ");
+                frame.color(DEFAULT_COLOR);
+                frame.append(itoc(currValue));
             }
+            frame.append(' ');
         }
-        cout << endl;
+        frame.append('\n');
+        if (frame.size() >= TERM_FRAME_BYTES)
+            frame.flush();
     }
 }
 
@@ -125,14 +146,102 @@ void ColorGrid::displayMaxSize(const string &algo) const {
     formatTxt(oss, LIGHT_CYAN);
 }
 
+void ColorGrid::fWriteRegions(const string &algo) const {
+    if (regionsFormat.empty())
+        return;
+    const string filepath = fRemoveExt(filename) + "_regions_" + algo + "." + regionsFormat;
+    mfh.writer.submit(regionsFormat == "json" ? regions.toJson() : regions.toCsv(),
+                      filepath, DEFAULT_INFO, true);
+}
+
+void ColorGrid::fWriteImage(const string &algo, const ImageRowFunc &rowFunc, bool regionLabels) const {
+    if (rasterFormat.empty())
+        return;
+    ostringstream path;
+    path << fRemoveExt(filename) << "_out_max" << maxSize << "_c" << maxColor << "_" << algo << "." << rasterFormat;
+    const string filepath = path.str();
+    if (!fHandleInfo(filepath, "image", true))
+        return;
+
+    ImageWriter image(filepath, m, n, rasterFormat == "png" ? ImageFormat::PNG : ImageFormat::PPM);
+    const bool regionColors = falseColor && regionLabels;
+
+    // value colors: lit for max region cells, dimmed for the others
+    uint8_t palette[2][MAX_VAL + 1][3];
+    for (int value = 0; value <= MAX_VAL; value++) {
+        getRgbFromKey(value, palette[1][value]);
+        for (int ch = 0; ch < 3; ch++)
+            palette[0][value][ch] = static_cast<uint8_t>(palette[1][value][ch] * IMAGE_DIM_LEVEL / 256);
+    }
+
+    // false colors: a bright pseudo-random color per region, keyed by its size, color & bounding box
+    // rather than its index, so it doesn't depend on the algorithm or the thread count
+    vector<array<uint8_t, 3>> regionRgb(regionColors ? regions.count() : 0);
+    for (int region = 0; region < static_cast<int>(regionRgb.size()); region++) {
+        uint64_t hash = splitMix64(static_cast<uint64_t>(regions.size[region]) << 8 | regions.color[region]);
+        hash = splitMix64(hash ^ (static_cast<uint64_t>(regions.minRow[region]) << 32 | uint32_t(regions.minCol[region])));
+        hash = splitMix64(hash ^ (static_cast<uint64_t>(regions.maxRow[region]) << 32 | uint32_t(regions.maxCol[region])));
+        for (int ch = 0; ch < 3; ch++)
+            regionRgb[region][ch] = static_cast<uint8_t>(64 + ((hash >> (8 * ch)) & 0xFF) * 3 / 4);
+    }
+
+    const size_t rowBytes = static_cast<size_t>(m) * 3;
+    const int bandRows = static_cast<int>(clamp<size_t>(IMAGE_BAND_BYTES / rowBytes, 1, n));
+    vector<uint8_t> band(rowBytes * bandRows);
+
+    for (int first = 0; first < n && !image.failed(); first += bandRows) {
+        const int bandEnd = min(n, first + bandRows);
+        MatFileHandler::forRowStrips(bandEnd - first, mfh.threads, [&](int lo, int hi) {
+            vector<Cell> cells(m);
+            vector<uint8_t> mask(m);
+            vector<int32_t> region(regionColors ? m : 0);
+            for (int r = lo; r < hi; r++) {
+                rowFunc(first + r, cells.data(), mask.data(), regionColors ? region.data() : nullptr);
+                uint8_t *out = band.data() + rowBytes * r;
+                for (int c = 0; c < m; c++, out += 3) {
+                    if (regionColors) {
+                        const uint8_t *rgb = regionRgb[region[c]].data();
+                        const int level = mask[c] ? 256 : IMAGE_DIM_LEVEL;
+                        for (int ch = 0; ch < 3; ch++)
+                            out[ch] = static_cast<uint8_t>(rgb[ch] * level / 256);
+                    }
+                    else
+                        memcpy(out, palette[mask[c] != 0][min<int>(cells[c], MAX_VAL)], 3);
+                }
+            }
+        });
+        image.writeRows(band.data(), bandEnd - first);
+    }
+    image.finish();
+}
+
+void ColorGrid::fWriteSparse(const string &filepath,
+                             int firstRow, int rows,
+                             int firstCol, int cols,
+                             const RowMaskFunc &rowMask) {
+    const string sparsePath = fRemoveExt(filepath) + "_" + resultFormat + sparseExt(resultFormat);
+    mfh.writer.submit(encodeSparse(resultFormat, firstRow, rows, firstCol, cols, m, rowMask),
+                      sparsePath, DEFAULT_INFO, true);
+}
+
 void ColorGrid::fWriteCropped(const string &filename,
                               int n, int m,
                               const function<bool(int, int)> &cellCondition,
                               const function<char(int, int)> &getCellValue,
                               const string &algo) {
 
-    int minRow = n, maxRow = -1, minCol = m, maxCol = -1;
-    calcBoundingBox(minRow, maxRow, minCol, maxCol, n, m, cellCondition);
+    BoundingBox box = { n, -1, m, -1 };
+    calcBoundingBox(box.minRow, box.maxRow, box.minCol, box.maxCol, n, m, cellCondition);
+    fWriteCropped(filename, n, m, box, cellCondition, getCellValue, algo);
+}
+
+void ColorGrid::fWriteCropped(const string &filename,
+                              int n, int m,
+                              const BoundingBox &box,
+                              const function<bool(int, int)> &cellCondition,
+                              const function<char(int, int)> &getCellValue,
+                              const string &algo) {
+    auto [minRow, maxRow, minCol, maxCol] = box;
 
     // Construct a unique file name based on the bounding box coordinates
     string filepath = updatePath(filename, maxColor, minRow, alignCol(minCol), maxRow, alignCol(maxCol), algo);
@@ -28,7 +28,7 @@ using namespace std;
 
 using namespace MyCommon;
 
-const string algoSelect = "Select the algorithm to use: 'DFS', 'UF', 'BOTH' (default: BOTH).\n";
+const string algoSelect = "Select the algorithm to use: 'DFS', 'UF', 'CCL', 'BOTH' (default: BOTH).\n";
 
 void mainMenuDisplay();
 
@@ -40,7 +40,17 @@ void handleArgs(int argc, char *argv[],
 	            MatFileHandler &mfh,
 	            bool & paint, bool &colors, 
 	            bool &crop, 
-				pair<bool, string> &visConfig);
+				pair<bool, string> &visConfig,
+				string &visMode,
+				string &ufPolicy,
+				int &threads,
+				string &regionsFormat,
+				string &rasterFormat,
+				bool &falseColor,
+				string &resultFormat,
+				bool &stream,
+				int &queueDepth,
+				bool &packed);
 
 void validateAndAssign(int &variable, const string &arg, int min_value, 
 	                   int max_value, map<string, string> &args_map);
@@ -53,6 +63,8 @@ void algoNotifier(const string &algo);
 
 void visualizerNotifier(const string &algo, bool &visEnable);
 
+void falseColorNotifier(const string &algo, bool &falseColor);
+
 void title_and_ver();
 
 void handleAlgoSelection(string &algo, const string &value= "uf");
@@ -26,16 +26,17 @@
 
 #include "../../common/headers/matfile_handler.hpp"
 #include "../../common/headers/helpers.hpp"
+#include "../../common/headers/term_frame.hpp"
+#include "../../common/headers/image_writer.hpp"
+#include "../../common/headers/sparse_result.hpp"
+#include "region_table.hpp"
 
 using namespace std;
 
-
 class ColorGrid {
 protected:
     MatFileHandler &mfh;
 
-    bool isValid(int row, int col, int n, int m);
-
     string updatePath(const string &filename, int maxSize,
         int maxColor, const string &algo,
         bool txt = EN_TXT);
@@ -62,6 +63,15 @@ public:
     vector<int> dr = { 1, -1, 0, 0, 1, -1, -1, 1 };
     vector<int> dc = { 0, 0, 1, -1, -1, -1, 1, 1 };
 
+    RegionTable regions;   // per-component statistics of the last solved matrix
+    string regionsFormat;  // --regions dump format (csv or json), empty if disabled
+    string rasterFormat;   // --image format (ppm or png), empty if disabled
+    string resultFormat;   // --result_format, one of RESULT_FORMATS
+    bool falseColor;       // --false_color: color the image by region rather than by value
+
+    // Fills row r of the image: its cells, its max-region mask & (if region isn't null) the region of each cell
+    using ImageRowFunc = function<void(int r, Cell *cells, uint8_t *mask, int32_t *region)>;
+
     virtual int calcMaxConnectedColor() = 0;
     
     // Default constructor deleted to enforce passing MatFileHandler
@@ -70,10 +80,12 @@ public:
     // Constructor with MatFileHandler initialization
     explicit ColorGrid(MatFileHandler &handler);
 
-    void init(vector<vector<int>> &mat);
+    // Reset stats for a new matrix (pads it with a sentinel border if needed)
+    void init(Grid &mat);
+    void init(const PackedGrid &mat);
     void setFileName(const string &path, vector<int> &matrixParams);
 
-    void paintResultsArea(vector<vector<int>> &matrix,
+    void paintResultsArea(const Grid &matrix,
                           bool colors,
                           function<bool(int, int)> cellCondition) const;
 
@@ -81,6 +93,15 @@ public:
 
     void displayMaxSize(const string &) const;
 
+    // Dump the region table next to the results, if requested (see regionsFormat)
+    void fWriteRegions(const string &algo) const;
+
+    // Render the solved matrix into an image next to the results, if requested (see rasterFormat).
+    // Bands of rows are rendered in parallel (mfh.threads), then streamed to the file.
+    // Engines without per-cell regions (regionLabels unset) get value colors even with falseColor.
+    void fWriteImage(const string &algo, const ImageRowFunc &rowFunc, bool regionLabels = true) const;
+
+    // Per-cell fallback, for arbitrary predicates
     template <typename ConditionFunc, typename ValueFunc>
     void fWriteAll(const string &filepath,
                    int n, int m,
@@ -90,12 +111,37 @@ public:
         fWriteResults(filepath, n, m, cellCondition, getCellValue, false);
     }
 
+    // Bulk variant (see MatFileHandler::fillBufferRows)
+    template <typename RowFunc>
+    void fWriteRows(const string &filepath, int n, int m, RowFunc rowCells) {
+        if (resultFormat != DEFAULT_RESULT_FORMAT) {
+            fWriteSparse(filepath, 0, n, 0, m, [&](int r, uint8_t *mask) { rowCells(r, mask); });
+            return;
+        }
+        mfh.writer.submit(mfh.fillBufferRows(rowCells, n, m), filepath, DEFAULT_INFO, true);
+    }
+
+    // Sparse results (see resultFormat & encodeSparse) of the window rows [firstRow, firstRow + rows)
+    // x cols [firstCol, firstCol + cols), saved next to the dense filepath
+    void fWriteSparse(const string &filepath,
+                      int firstRow, int rows,
+                      int firstCol, int cols,
+                      const RowMaskFunc &rowMask);
+
     void fWriteCropped(const string &filename,
                        int n, int m,
                        const function<bool(int, int)> &cellCondition,
                        const function<char(int, int)> &getCellValue,
                        const string &algo);
 
+    // Same, with the bounding box already known (skips the full-matrix scan)
+    void fWriteCropped(const string &filename,
+                       int n, int m,
+                       const BoundingBox &box,
+                       const function<bool(int, int)> &cellCondition,
+                       const function<char(int, int)> &getCellValue,
+                       const string &algo);
+
     template <typename ConditionFunc, typename ValueFunc>
     void fWriteResults(const string &filepath,
                        int n, int m,
@@ -116,8 +162,17 @@ public:
             maxCol = m - 1;
         }
 
-        auto buffer = mfh.fillBuffer(cellCondition, getValue, minRow, maxRow, minCol, maxCol);
-        fWrite(buffer, filepath, DEFAULT_INFO, true);
+        if (resultFormat != DEFAULT_RESULT_FORMAT) {
+            fWriteSparse(filepath, minRow, maxRow - minRow + 1, minCol, maxCol - minCol + 1,
+                         [&](int r, uint8_t *mask) {
+                for (int c = minCol; c <= maxCol; c++)
+                    mask[c] = cellCondition(r, c);
+            });
+            return;
+        }
+
+        mfh.writer.submit(mfh.fillBuffer(cellCondition, getValue, minRow, maxRow, minCol, maxCol),
+                          filepath, DEFAULT_INFO, true);
     }
 
     //update MatFileHandler filename member
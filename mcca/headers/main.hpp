@@ -22,20 +22,47 @@
 #include "cli_utils.hpp"
 #include "max_color_uf.hpp"
 #include "max_color_dfs.hpp"
+#include "max_color_ccl.hpp"
+#include "max_color_run.hpp"
+#include "stream_color_grid.hpp"
+#include "../../common/headers/bounded_queue.hpp"
+
+#include <thread>
 
 void solveMccg(DfsColorGrid &dfsCG, 
                UnionFindColorGrid &ufCG,
-               vector<vector<int>> &mat,
+               CclColorGrid &cclCG,
+               RunColorGrid &runCG,
+               Grid &mat,
                const string &algo,
                bool &paint,
                bool &colors, 
                bool crop, 
                const string &filepath = "");
 
+// UF labels the packed matrix as is, DFS, CCL & RUN get it unpacked
+void solveMccg(DfsColorGrid &dfsCG,
+               UnionFindColorGrid &ufCG,
+               CclColorGrid &cclCG,
+               RunColorGrid &runCG,
+               const PackedGrid &mat,
+               const string &algo,
+               bool &paint,
+               bool &colors,
+               bool crop,
+               const string &filepath = "");
+
 void processData(DfsColorGrid &dfsCG, 
                  UnionFindColorGrid &ufCG,
+                 CclColorGrid &cclCG,
+                 RunColorGrid &runCG,
                  MatFileHandler &mfh,
                  const string &algo,
                  bool &paint, 
                  bool& colors, 
-                 bool crop);
\ No newline at end of file
+                 bool crop,
+                 int queueDepth = DEFAULT_QUEUE_DEPTH,
+                 bool packed = false);
+
+// Label every matrix file under root_dir in streaming mode (--stream)
+void processStream(StreamColorGrid &streamCG, MatFileHandler &mfh);
\ No newline at end of file
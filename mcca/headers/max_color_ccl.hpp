@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include "color_grid.hpp"
+#include "../../common/headers/matfile_handler.hpp"
+
+using namespace std;
+
+// Two-pass connected-component labeling (8-connectivity):
+// raster pass with a decision tree over the visited neighbors (NW, N, NE, W),
+// a provisional-label equivalence table, then a flatten pass to final labels.
+class CclColorGrid : public ColorGrid {
+private:
+    const string algo = "CCL";
+
+public:
+
+    CclColorGrid() = delete;
+
+    explicit CclColorGrid(MatFileHandler &handler);
+
+    virtual int calcMaxConnectedColor() override;
+
+    int calcMaxConnectedColor(Grid &mat,
+                              bool paint = true,
+                              bool colors = true,
+                              const string &filepath = "",
+                              bool crop = false);
+
+protected:
+    vector<int> labels;        // per cell: provisional label (1st pass), final label (2nd pass)
+    vector<int> equivalences;  // provisional label -> parent label (roots point to themselves)
+    vector<Cell> labelColors;  // provisional label -> color code
+                               // final label L is row L - 1 of the region table
+
+    int newLabel(Cell color);
+
+    int findRoot(int label) const;
+
+    void setRoot(int label, int root);
+
+    // record the equivalence of two provisional labels, return their common root
+    int merge(int label1, int label2);
+
+    void labelingPass(const Grid &mat);
+
+    // resolve provisional labels into consecutive final labels (adding their regions), return their count
+    int flatten();
+};
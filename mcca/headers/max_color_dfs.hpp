@@ -36,14 +36,35 @@ public:
       
     virtual int calcMaxConnectedColor() override;
 
-    int calcMaxConnectedColor(vector<vector<int>> &mat, 
+    int calcMaxConnectedColor(Grid &mat, 
                               bool paint = true, 
                               bool colors = true, 
                               const string &filepath = "",
                               bool crop = false);
 
 protected:
-    int dfs(vector<vector<int>> &mat, int curr_value,
-            int row, int col, vector<vector<bool>> &checked,
-            vector<pair<int, int>> &coord_list);
+    // Horizontal run of cells [first, last] within a row
+    struct Span {
+        int row, first, last;
+    };
+
+    // Visited cells, one bit per cell (row-major)
+    vector<uint64_t> visited;
+    // Work stack of fill seeds, reused across components
+    vector<pair<int, int>> fillStack;
+    // Runs of the component being filled / of the max component so far
+    vector<Span> currSpans, maxSpans;
+    // Max region as a dense bitmask (row-major)
+    vector<uint64_t> maxMask;
+
+    static bool testBit(const vector<uint64_t> &bits, size_t idx);
+    static void setBit(vector<uint64_t> &bits, size_t idx);
+
+    bool isVisited(int row, int col) const;
+    void markVisited(int row, int col);
+
+    // Iterative scanline flood fill of a new region (row of the region table) -
+    // returns the component size, its runs are left in spans
+    int dfs(const Grid &mat, int curr_value, int row, int col,
+            vector<Span> &spans, int region);
 };
\ No newline at end of file
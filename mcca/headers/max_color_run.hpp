@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "max_color_ccl.hpp"
+
+using namespace std;
+
+// Run-based labeling (8-connectivity): every row is split into maximal same-color runs
+// (SIMD equality masks of the row against itself shifted by one), runs of adjacent rows are
+// merged when they overlap or touch diagonally, and region sizes sum up run lengths.
+// The equivalence table (see CclColorGrid) holds one provisional label per run, not per cell,
+// so blocky matrices are labeled with thousands of unions instead of millions.
+class RunColorGrid : public CclColorGrid {
+private:
+    const string algo = "RUN";
+
+public:
+
+    RunColorGrid() = delete;
+
+    explicit RunColorGrid(MatFileHandler &handler);
+
+    virtual int calcMaxConnectedColor() override;
+
+    int calcMaxConnectedColor(Grid &mat,
+                              bool paint = true,
+                              bool colors = true,
+                              const string &filepath = "",
+                              bool crop = false);
+
+    // Bitmaps of row r (bit c of word c / 64): eqW - cell c equals its W neighbor,
+    // inner - cell c equals both its N & S neighbors. Relies on the sentinel border.
+    static void rowMasks(const Grid &mat, int r, uint64_t *eqW, uint64_t *inner);
+
+protected:
+    struct Run {
+        int first, last;  // columns, inclusive
+        int label;        // provisional label (1st pass), final label (2nd pass)
+        int boundary;     // cells with a 4-neighbor outside the region
+    };
+
+    vector<Run> runs;      // row-major
+    vector<int> rowStart;  // runs of row r: [rowStart[r], rowStart[r + 1])
+    vector<uint64_t> eqW, inner;
+
+    // Split row r into runs, label them from the overlapping runs of row r - 1
+    void labelRow(const Grid &mat, int r);
+
+    // Final label of cell (r, c) - binary search over the runs of row r
+    int cellLabel(int r, int c) const;
+};
@@ -23,7 +23,9 @@
 #include "union_find.hpp"
 
 #include <fstream>
+#include <set>
 #include <string>
+#include <unordered_map>
 
 using namespace std;
 
@@ -36,16 +38,9 @@ private:
 public:
     bool visualizerEn;  // specific to UF 
     string imageFormat; // for visualizer 
-
-    // Hash function for pairs of integers
-    struct hash_pair {
-        template <class T1, class T2>
-        size_t operator() (const pair<T1, T2> &p) const {
-            auto h1 = hash<T1>{}(p.first);
-            auto h2 = hash<T2>{}(p.second);
-            return h1 ^ (h2 << 1);  // Combine the two hashes, shift to avoid collision
-        }
-    };
+    string visMode;     // visualizer graph, one of VIS_MODES
+    string ufPolicy;    // find/union policy combination, one of UF_POLICIES
+    int threads;        // strip-parallel labeling workers
 
     UnionFindColorGrid() = delete;
 
@@ -53,42 +48,90 @@ public:
 
     virtual int calcMaxConnectedColor() override;
 
-    int calcMaxConnectedColor(vector<vector<int>> &mat,
+    int calcMaxConnectedColor(Grid &mat,
                               bool paint = true,
                               bool colors = true,
                               const string &filepath = "", 
                               bool crop = false);
 
+    // Label a nibble-packed matrix in place (no unpacking, except for painting)
+    int calcMaxConnectedColor(const PackedGrid &mat,
+                              bool paint = true,
+                              bool colors = true,
+                              const string &filepath = "",
+                              bool crop = false);
+
 protected:
-    unordered_set<int> maxColorSet;  // Specific to UnionFindColorGrid (for O(1) color code lookup)
+    set<int> maxColorSet;  // Specific to UnionFindColorGrid (color codes of all max-size regions, ordered)
     unordered_map<int, unordered_set<int>> colorRegionsMap;  // Specific to UnionFindColorGrid (to track regions of each color code)
 
-    void visualizeUF(UnionFind &uf,
-                     int maxSize,
+    // Flattened UnionFind: dense region index per cell (into regions) & the root of each region
+    vector<int32_t> cellRegion;
+    vector<int> regionRoot;
+    vector<int> maxRegions;  // regions of size maxSize, by color code
+
+    // Pick the UnionFind policy combination (see ufPolicy)
+    template <typename Matrix>
+    int solve(const Matrix &mat, bool paint, bool colors,
+              const string &filepath, bool crop);
+
+    // Label with the given UnionFind policy combination, then report the results
+    template <typename UF, typename Matrix>
+    int solveWith(UF &uf, const Matrix &mat, bool paint, bool colors,
+                  const string &filepath, bool crop);
+
+    // Write the visualizer dot file (per visMode) from the flattened regions & render it
+    void visualizeUF(int maxSize,
                      const string &filename,
                      bool show = false);
 
-    const char *getRegionColor(int root, const unordered_map<int, unordered_set<int>> &colorRegionsMap) const;
+    // tree: one node per cell, linked to its root; max regions filled with their color
+    void writeTreeDot(ofstream &dotFile) const;
+
+    // condensed: one node per region (area ~ size, filled with its color), one edge per 4-adjacent pair
+    void writeCondensedDot(ofstream &dotFile) const;
 
     void notifyMaxColorRegions(const string &filename, int maxSize,
-                               const unordered_set<int> &maxColorSet,
+                               const set<int> &maxColorSet,
                                const unordered_map<int, unordered_set<int>> &colorRegionsMap, 
                                bool extraFile = false);
 
+    // Unite a cell with its already-visited (W, NW, N, NE) same-color neighbors
+    template <typename UF>
     void processAdjCells(int row, int col,
-                         vector<vector<int>> &matrix,
+                         const Grid &matrix,
                          int currCell,
                          int currValue,
-                         UnionFind &uf,
-                         unordered_set<pair<int, int>, hash_pair> &loggedPairs
+                         UF &uf
                         );
 
+    template <typename UF>
+    void labelRows(UF &uf, const Grid &mat, int firstRow, int lastRow,
+                   bool joinUpperRow, pair<int, int> &valueStats);
+
+    // Same unions in the same order, with the neighbor equality tests done on whole words
+    template <typename UF>
+    void labelRows(UF &uf, const PackedGrid &mat, int firstRow, int lastRow,
+                   bool joinUpperRow, pair<int, int> &valueStats);
+
+    // Strip-parallel labeling pass (see threads)
+    template <typename UF, typename Matrix>
+    void labelStrips(UF &uf, const Matrix &mat);
+
+    // Shared-memory parallel labeling pass on the lock-free UnionFind (LOCKFREE policy)
+    template <typename Matrix>
+    void labelShared(ConcurrentUnionFind &uf, const Matrix &mat);
+
+    // Resolve every cell's root once into cellRegion & fill the region table
+    template <typename UF, typename Matrix>
+    void flattenRegions(const Matrix &matrix, UF &uf);
+
+    // Derive maxSize, maxColor, maxColorSet & colorRegionsMap from the region table
+    void collectMaxRegions();
+
     //For --crop option (only write each bounding box of equally-sized max region to separate file)
     void fWriteCropped(const string &filename,
-                       UnionFind &uf,
-                       vector<vector<int>> &mat,
                        int n, int m,
-                       const function<bool(int, int)> &cellCondition,
                        const function<char(int, int)> &getCellValue
                       );
 };
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../../common/headers/grid.hpp"
+#include "../../common/headers/packed_grid.hpp"
+
+using namespace std;
+
+// Bounding box or minimum bounding rectangle (MBR) of a region, inclusive
+struct BoundingBox {
+    int minRow, maxRow, minCol, maxCol;
+};
+
+// Per-component statistics, one struct-of-arrays row per region.
+// Engines fill it while labeling; regions are numbered in the order they were added.
+class RegionTable {
+public:
+    vector<int> size, color;
+    vector<int> minRow, maxRow, minCol, maxCol;
+    vector<int64_t> rowSum, colSum;  // centroid = sum / size
+    vector<int> boundary;            // cells with a 4-neighbor outside the region (or the matrix)
+
+    void clear();
+
+    int count() const { return static_cast<int>(size.size()); }
+
+    // Append an empty region, returns its index
+    int addRegion(int colorCode);
+
+    // Add the run [first, last] of row
+    void addRun(int region, int row, int first, int last, int boundaryCells) {
+        const int len = last - first + 1;
+        size[region] += len;
+        minRow[region] = min(minRow[region], row);
+        maxRow[region] = max(maxRow[region], row);
+        minCol[region] = min(minCol[region], first);
+        maxCol[region] = max(maxCol[region], last);
+        rowSum[region] += static_cast<int64_t>(row) * len;
+        colSum[region] += (static_cast<int64_t>(first) + last) * len / 2;
+        boundary[region] += boundaryCells;
+    }
+
+    // Add every run of equal labels in a labeled row, labels[c] + labelOffset being the region of column c.
+    // Such a run is a maximal same-valued run (any same-valued W/E neighbor joins the region),
+    // so its end cells are always boundary cells & only its interior needs the N/S test.
+    template <typename Label>
+    void addRow(const Grid &mat, int row, const Label *labels, int labelOffset = 0) {
+        const int cols = mat.cols();
+        const Cell *curr = mat.row(row), *up = mat.row(row - 1), *down = mat.row(row + 1);
+        for (int first = 0, last; first < cols; first = last + 1) {
+            const Label label = labels[first];
+            for (last = first; last + 1 < cols && labels[last + 1] == label; last++);
+
+            const Cell value = curr[first];
+            int boundaryCells = (last > first) ? 2 : 1;
+            for (int c = first + 1; c < last; c++)
+                boundaryCells += (up[c] != value) | (down[c] != value);
+            addRun(label + labelOffset, row, first, last, boundaryCells);
+        }
+    }
+
+    // Same on a packed grid, the interior N/S tests running on whole words
+    template <typename Label>
+    void addRow(const PackedGrid &mat, int row, const Label *labels, int labelOffset = 0) {
+        constexpr int WORD_CELLS = PackedGrid::CELLS_PER_WORD;
+        const int cols = mat.cols();
+        const uint64_t *curr = mat.row(row), *up = mat.row(row - 1), *down = mat.row(row + 1);
+        for (int first = 0, last; first < cols; first = last + 1) {
+            const Label label = labels[first];
+            for (last = first; last + 1 < cols && labels[last + 1] == label; last++);
+
+            int boundaryCells = (last > first) ? 2 : 1;
+            for (int c = first + 1; c < last;) {
+                const int w = c / WORD_CELLS;
+                const int end = min(last, (w + 1) * WORD_CELLS);
+                const int lo = c % WORD_CELLS;
+                const uint64_t span = (PackedGrid::NIBBLE_LSB >> (4 * (WORD_CELLS - (end - c)))) << (4 * lo);
+                const uint64_t inner = PackedGrid::nibbleEq(curr[w], up[w]) & PackedGrid::nibbleEq(curr[w], down[w]);
+                boundaryCells += (end - c) - popcount(inner & span);
+                c = end;
+            }
+            addRun(label + labelOffset, row, first, last, boundaryCells);
+        }
+    }
+
+    BoundingBox box(int region) const;
+
+    double centroidRow(int region) const;
+    double centroidCol(int region) const;
+
+    string toCsv() const;
+    string toJson() const;
+
+    // Region boundary test for 8-connected regions: a same-valued 4-neighbor always belongs
+    // to the region, so it suffices to compare values. Relies on the sentinel border.
+    static bool isBoundaryCell(const Grid &mat, int row, int col) {
+        const Cell value = mat(row, col);
+        return mat(row - 1, col) != value || mat(row + 1, col) != value ||
+               mat(row, col - 1) != value || mat(row, col + 1) != value;
+    }
+};
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma once
+
+#include "color_grid.hpp"
+#include "../../common/headers/mat_row_reader.hpp"
+#include "../../common/headers/mccb_file.hpp"
+
+using namespace std;
+
+// Streaming labeling (8-connectivity) for matrices larger than RAM:
+// the file is parsed row by row and only the previous & current rows are resident.
+// Labels form a small union-find whose roots carry their component's running stats;
+// once a component has no cell in the current row it is closed & its labels recycled,
+// so memory stays O(cols). Reports max size, color & bounding box only.
+// .mccb files are mapped & decoded (PACKED4) a row at a time, their clean pages staying reclaimable.
+class StreamColorGrid : public ColorGrid {
+private:
+    const string algo = "STREAM";
+
+public:
+    int64_t maxRegionSize;  // may exceed int range on huge matrices (maxSize is clamped)
+    BoundingBox maxBox;
+
+    StreamColorGrid() = delete;
+
+    explicit StreamColorGrid(MatFileHandler &handler);
+
+    virtual int calcMaxConnectedColor() override;
+
+    // Label a matrix file - false on a parse error (already reported)
+    bool calcMaxConnectedColor(const string &filepath);
+
+protected:
+    int64_t maxFirstCell;  // raster index of the max region's first cell (DFS tie-breaking)
+
+    // Label table (label 0 means none), indexed by label
+    vector<int> parent;
+    vector<int64_t> size, firstCell;
+    vector<Cell> color;
+    vector<BoundingBox> box;
+    vector<int> seenRow;  // last row referencing a root label
+    vector<int> liveLabels, nextLiveLabels, freeLabels;
+
+    // The two resident rows & their labels, padded by one sentinel column on each side
+    vector<Cell> prevRow, currRow;
+    vector<int> prevLabels, currLabels;
+
+    // Label the rows produced by nextRow(vector<Cell> &) until it returns false
+    template <typename NextRow, typename Failed>
+    bool labelStream(NextRow nextRow, Failed failed);
+
+    int newLabel(Cell value, int row, int col);
+
+    int find(int label);
+
+    // Union by size, merging the stats into the new root - returns it
+    int unite(int label1, int label2);
+
+    void labelRow(int row);
+
+    // Point the row's cells to their roots, then close unreferenced components & free their labels
+    void recycleLabels(int row);
+
+    void closeComponent(int root);
+
+    void displayMaxRegion() const;
+};
@@ -19,17 +19,177 @@
 
 #pragma once 
 
+#include <atomic>
+#include <cstdint>
+#include <string>
 #include <vector>
 
 using namespace std; 
 
+// All union-find variants share a single int32 array:
+// parent[x] >= 0 is the parent index of x, parent[x] < 0 marks a root holding -(set size).
+
+// Find policies (iterative, so depth is never bounded by the call stack)
+
+// Two passes: locate the root, then point every node on the path straight to it
+struct PathCompression {
+    static int32_t find(vector<int32_t> &parent, int32_t x) {
+        int32_t root = x;
+        while (parent[root] >= 0)
+            root = parent[root];
+        while (parent[x] >= 0 && parent[x] != root) {
+            int32_t next = parent[x];
+            parent[x] = root;
+            x = next;
+        }
+        return root;
+    }
+};
+
+// One pass: every other node on the path skips to its grandparent
+struct PathHalving {
+    static int32_t find(vector<int32_t> &parent, int32_t x) {
+        while (parent[x] >= 0) {
+            int32_t p = parent[x];
+            if (parent[p] >= 0)
+                parent[x] = parent[p];
+            x = parent[x];
+        }
+        return x;
+    }
+};
+
+// One pass: every node on the path is pointed to its grandparent
+struct PathSplitting {
+    static int32_t find(vector<int32_t> &parent, int32_t x) {
+        while (parent[x] >= 0) {
+            int32_t p = parent[x];
+            if (parent[p] >= 0)
+                parent[x] = parent[p];
+            x = p;
+        }
+        return x;
+    }
+};
+
+// Union policies
+
+// Link the smaller tree under the larger one
+struct UnionBySize {
+    template <typename FindPolicy>
+    static void unite(vector<int32_t> &parent, int32_t x, int32_t y) {
+        int32_t rootX = FindPolicy::find(parent, x);
+        int32_t rootY = FindPolicy::find(parent, y);
+        if (rootX == rootY)
+            return;
+        if (parent[rootX] > parent[rootY])  // sizes are negated
+            swap(rootX, rootY);
+        parent[rootX] += parent[rootY];
+        parent[rootY] = rootX;
+    }
+};
+
+// Rem's algorithm: both paths are climbed in an interleaved fashion, always advancing the node
+// whose parent has the smaller index, and stopping as soon as they meet (same set).
+// A root is only ever linked under a larger index, so every set's root is its largest cell index
+// (independent of the union order). Splicing is left out: it moves subtrees between the two sets
+// before the union completes, which the root-held sizes cannot follow.
+struct RemUnion {
+    template <typename FindPolicy>
+    static void unite(vector<int32_t> &parent, int32_t x, int32_t y) {
+        auto parentOf = [&](int32_t i) { return parent[i] < 0 ? i : parent[i]; };
+        int32_t px = parentOf(x);
+        int32_t py = parentOf(y);
+        while (px != py) {
+            if (px < py) {
+                swap(x, y);
+                swap(px, py);
+            }
+            if (y == py) {  // y is a root: link it below the (larger) px
+                int32_t sizeY = parent[y];
+                parent[y] = px;
+                parent[FindPolicy::find(parent, px)] += sizeY;
+                return;
+            }
+            y = py;
+            py = parentOf(y);
+        }
+    }
+};
+
+template <typename FindPolicy = PathHalving, typename UnionPolicy = UnionBySize>
 class UnionFind {
 public:
-    vector<int> parent;
-    vector<int> size;
+    vector<int32_t> parent;  // parent index, or -(set size) for roots
+
+    explicit UnionFind(int n);
+
+    int find(int x) { return FindPolicy::find(parent, x); }
+
+    void unite(int x, int y) { UnionPolicy::template unite<FindPolicy>(parent, x, y); }
+
+    int getSize(int x) { return -parent[find(x)]; }
+
+    bool isRoot(int x) const { return parent[x] < 0; }
+
+    // size of the set rooted at root (root must satisfy isRoot)
+    int rootSize(int root) const { return -parent[root]; }
+};
+
+// Lock-free union-find: any number of threads may unite cells concurrently, in any order.
+// While uniting, roots point to themselves; unite links the smaller-index root under the larger
+// one with a single CAS on its parent word (retrying if that root was linked meanwhile), and find
+// halves paths with CAS (a failed CAS only means another thread already shortened that link).
+// Parents only ever grow, so no cycles can form. Once all unions are done, finalize() switches
+// to the UnionFind layout (roots hold -size), after which the sequential accessors apply.
+class ConcurrentUnionFind {
+public:
+    vector<atomic<int32_t>> parent;
+
+    explicit ConcurrentUnionFind(int n);
 
-    UnionFind(int n);
-    int find(int x);
-    void unite(int x, int y);
-    int getSize(int x);
+    int find(int x) {
+        while (true) {
+            int32_t p = parent[x].load(memory_order_relaxed);
+            if (p < 0 || p == x)
+                return x;
+            int32_t gp = parent[p].load(memory_order_relaxed);
+            if (gp < 0 || gp == p)
+                return p;
+            parent[x].compare_exchange_weak(p, gp, memory_order_relaxed);
+            x = gp;
+        }
+    }
+
+    void unite(int x, int y) {
+        while (true) {
+            x = find(x);
+            y = find(y);
+            if (x == y)
+                return;
+            if (x < y)
+                swap(x, y);
+            int32_t expected = y;
+            if (parent[y].compare_exchange_strong(expected, x, memory_order_acq_rel))
+                return;
+        }
+    }
+
+    // Compress every cell to its root and store -size in the roots (uses up to threads workers).
+    // Must not overlap with unite.
+    void finalize(int threads);
+
+    int getSize(int x) { return -parent[find(x)].load(memory_order_relaxed); }
+
+    bool isRoot(int x) const { return parent[x].load(memory_order_relaxed) < 0; }
+
+    int rootSize(int root) const { return -parent[root].load(memory_order_relaxed); }
 };
+
+// Policy combinations selectable through --uf_policy (UF_POLICIES)
+using CompressUnionFind = UnionFind<PathCompression, UnionBySize>;
+using HalvingUnionFind = UnionFind<PathHalving, UnionBySize>;
+using SplittingUnionFind = UnionFind<PathSplitting, UnionBySize>;
+using RemUnionFind = UnionFind<PathSplitting, RemUnion>;
+
+bool isInvalidUfPolicy(const string &policy);
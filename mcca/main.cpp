@@ -32,6 +32,26 @@ int main(int argc, char *argv[]) {
 
     pair<bool, string> visConfig; 
 
+    string visMode = DEFAULT_VIS_MODE;
+
+    string ufPolicy = DEFAULT_UF_POLICY;
+
+    int threads = DEFAULT_THREADS;
+
+    string regionsFormat;
+
+    string rasterFormat;
+
+    bool falseColor = false;
+
+    string resultFormat = DEFAULT_RESULT_FORMAT;
+
+    bool stream = false;
+
+    int queueDepth = DEFAULT_QUEUE_DEPTH;
+
+    bool packed = false;
+
     signal(SIGINT, handleSignal);
 
     MatFileHandler mfh;
@@ -40,37 +60,57 @@ int main(int argc, char *argv[]) {
 
     DfsColorGrid dfsCG(mfh);
     UnionFindColorGrid ufCG(mfh);
+    CclColorGrid cclCG(mfh);
+    RunColorGrid runCG(mfh);
+    StreamColorGrid streamCG(mfh);
 
-    handleArgs(argc, argv, matStr, algoChoice, mfh, paint, colors, crop, visConfig);  // Parse CLI arguments
+    handleArgs(argc, argv, matStr, algoChoice, mfh, paint, colors, crop, visConfig, visMode, ufPolicy, threads, regionsFormat, rasterFormat, falseColor, resultFormat, stream, queueDepth, packed);  // Parse CLI arguments
 
     ufCG.visualizerEn = visConfig.first; 
     ufCG.imageFormat = visConfig.second;
+    ufCG.visMode = visMode;
+    ufCG.ufPolicy = ufPolicy;
+    ufCG.threads = threads;
 
     algoNotifier(algoChoice);
 
     visualizerNotifier(algoChoice, visConfig.first);
 
-    if (matStr.empty())
-        processData(dfsCG, ufCG, mfh, algoChoice,
-                    paint, colors, crop);
+    falseColorNotifier(algoChoice, falseColor);
+
+    for (ColorGrid *cg : initializer_list<ColorGrid *>{ &dfsCG, &ufCG, &cclCG, &runCG }) {
+        cg->regionsFormat = regionsFormat;
+        cg->rasterFormat = rasterFormat;
+        cg->falseColor = falseColor;
+        cg->resultFormat = resultFormat;
+    }
+
+    if (matStr.empty() && stream)
+        processStream(streamCG, mfh);
+    else if (matStr.empty())
+        processData(dfsCG, ufCG, cclCG, runCG, mfh, algoChoice,
+                    paint, colors, crop, queueDepth, packed);
     else{
-        vector<vector<vector<int>>> matList;
+        vector<Grid> matList;
         mfh.overwrite = true;
         matList = mfh.parseMatrices(matStr);
-        for (vector<vector<int>> &mat : matList) {
-            mfh.currMat = mat; 
+        for (Grid &mat : matList) {
+            mfh.currMat = std::move(mat); 
             mfh.parsedMatIdx++;
-            solveMccg(dfsCG, ufCG, mfh.currMat, algoChoice, 
+            solveMccg(dfsCG, ufCG, cclCG, runCG, mfh.currMat, algoChoice, 
                       paint, colors, crop);     
             mfh.fWriteMat(mfh.filename, true);
         }
     }
+    mfh.writer.flush();
     return 0;
 }
 
 void solveMccg(DfsColorGrid &dfsCG,
                UnionFindColorGrid &ufCG,
-               vector<vector<int>> &mat,
+               CclColorGrid &cclCG,
+               RunColorGrid &runCG,
+               Grid &mat,
                const string &algo,
                bool &paint,
                bool &colors, bool crop,
@@ -82,26 +122,113 @@ void solveMccg(DfsColorGrid &dfsCG,
     if (algo == "UF" || algo == "BOTH") {
         ufCG.calcMaxConnectedColor(mat, paint, colors, filepath, crop);
     }
+    if (algo == "CCL") {
+        cclCG.calcMaxConnectedColor(mat, paint, colors, filepath, crop);
+    }
+    if (algo == "RUN") {
+        runCG.calcMaxConnectedColor(mat, paint, colors, filepath, crop);
+    }
 }
 
+void solveMccg(DfsColorGrid &dfsCG,
+               UnionFindColorGrid &ufCG,
+               CclColorGrid &cclCG,
+               RunColorGrid &runCG,
+               const PackedGrid &mat,
+               const string &algo,
+               bool &paint,
+               bool &colors, bool crop,
+               const string &filepath) {
+
+    if (algo == "DFS" || algo == "BOTH" || algo == "CCL" || algo == "RUN") {
+        Grid unpacked = mat.unpack();
+        solveMccg(dfsCG, ufCG, cclCG, runCG, unpacked, algo == "BOTH" ? "DFS" : algo,
+                  paint, colors, crop, filepath);
+    }
+    if (algo == "UF" || algo == "BOTH") {
+        ufCG.calcMaxConnectedColor(mat, paint, colors, filepath, crop);
+    }
+}
+
+// Pipelined: a loader thread parses the files ahead of the solver, into a queue of at most
+// queueDepth matrices. Files the vectorized parser (or the .mccb loader) rejects are reloaded by
+// the solver thread with the reporting fallback, so all console output (errors included) stays in file order.
+// With packed set, queued matrices are nibble-packed (4 bits per cell).
 void processData(DfsColorGrid &dfsCG, 
                  UnionFindColorGrid &ufCG,
+                 CclColorGrid &cclCG,
+                 RunColorGrid &runCG,
                  MatFileHandler &mfh,
                  const string &algo,
                  bool &paint, bool &colors, 
-                 bool crop) {
-    vector<pair<string, vector<vector<int>>>> data = mfh.fLoadMatrices();
-    const int num_of_matrices = static_cast<int>(data.size());
-    if (num_of_matrices > 0) {
-        formatTxt("Processing data...\n", LIGHT_CYAN);
-        for (int k = 0; k < num_of_matrices; k++) {
-            string filepath = data[k].first;
-            mfh.currMat = std::move(data[k].second);
-            ostringstream oss;
-            oss << "\n" << k + 1 << ")" << filepath << "\n";
-            formatTxt(oss, LIGHT_CYAN);
-            solveMccg(dfsCG, ufCG, mfh.currMat, algo,
-                      paint, colors, crop, filepath);
+                 bool crop,
+                 int queueDepth,
+                 bool packed) {
+    struct LoadedMat {
+        string filepath;
+        Grid mat;
+        PackedGrid packedMat;
+        bool loaded;
+    };
+
+    const vector<string> filepaths = mfh.listMatFiles();
+    BoundedQueue<LoadedMat> queue(queueDepth);
+
+    thread loader([&]() {
+        for (const string &filepath : filepaths) {
+            LoadedMat item = { filepath, {}, {}, false };
+            item.loaded = mfh.matLoaderQuiet(item.mat, filepath);
+            if (packed && item.loaded) {
+                item.packedMat = PackedGrid(item.mat);
+                item.mat = Grid();
+            }
+            if (!queue.push(std::move(item)))
+                break;
+        }
+        queue.close();
+    });
+
+    formatTxt("Processing data...\n", LIGHT_CYAN);
+    int filecount = 0, k = 0;
+    while (auto item = queue.pop()) {
+        ++filecount;
+        // Files the quiet loader rejected are listed as they are loaded (numbered among all files),
+        // followed by their errors. Only loaded matrices are numbered for processing.
+        if (!item->loaded) {
+            ostringstream loading;
+            loading << "\nLoading " << filecount << ")" << item->filepath;
+            formatTxt(loading, LIGHT_CYAN);
+            const bool loaded = mfh.matLoaderFallback(item->mat, item->filepath);
+            cout << endl;
+            if (!loaded)
+                continue;
         }
+        if ((packed && item->loaded) ? item->packedMat.empty() : item->mat.empty())
+            continue;
+        ostringstream oss;
+        oss << "\n" << ++k << ")" << item->filepath << "\n";
+        formatTxt(oss, LIGHT_CYAN);
+        if (packed) {
+            if (!item->loaded)
+                item->packedMat = PackedGrid(item->mat);
+            solveMccg(dfsCG, ufCG, cclCG, runCG, item->packedMat, algo,
+                      paint, colors, crop, item->filepath);
+            continue;
+        }
+        mfh.currMat = std::move(item->mat);
+        solveMccg(dfsCG, ufCG, cclCG, runCG, mfh.currMat, algo,
+                  paint, colors, crop, item->filepath);
+    }
+    loader.join();
+}
+
+void processStream(StreamColorGrid &streamCG, MatFileHandler &mfh) {
+    formatTxt("Streaming data...\n", LIGHT_CYAN);
+    int filecount = 0;
+    for (const string &filepath : mfh.listMatFiles()) {
+        ostringstream oss;
+        oss << "\n" << ++filecount << ")" << filepath << "\n";
+        formatTxt(oss, LIGHT_CYAN);
+        streamCG.calcMaxConnectedColor(filepath);
     }
 }
\ No newline at end of file
@@ -0,0 +1,203 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma warning(push)
+#pragma warning(disable : 26495)  // Disable uninitialized variable warning (which occured despite a proper init within base class)
+
+#include "headers/max_color_ccl.hpp"
+
+CclColorGrid::CclColorGrid(MatFileHandler &handler) : ColorGrid(handler) {}
+
+int CclColorGrid::calcMaxConnectedColor() {
+    return 0;
+}
+
+int CclColorGrid::calcMaxConnectedColor(Grid &mat,
+                                        bool paint,
+                                        bool colors,
+                                        const string &filepath,
+                                        bool crop) {
+    init(mat);
+
+    labelingPass(mat);
+
+    const int numOfRegions = flatten();
+
+    // 2nd pass: replace provisional labels by final ones & accumulate region stats
+    for (int r = 0; r < n; r++) {
+        int *row = labels.data() + static_cast<size_t>(r) * m;
+        for (int c = 0; c < m; c++)
+            row[c] = equivalences[row[c]];
+        regions.addRow(mat, r, row, -1);
+    }
+
+    // Final labels follow the raster order of each region's first cell,
+    // so the first max region found here is the same one DFS reports
+    int maxRegion = 0;
+    for (int region = 0; region < numOfRegions; region++) {
+        updateValueStats(regions.color[region]);
+        if (regions.size[region] > regions.size[maxRegion])
+            maxRegion = region;
+    }
+    const int maxLabel = maxRegion + 1;
+    maxSize = regions.size[maxRegion];
+    maxColor = regions.color[maxRegion];
+
+    updateMfhFilename(filepath);
+
+    auto cellCond = [&](int r, int c) -> bool {
+        return labels[static_cast<size_t>(r) * m + c] == maxLabel;
+        };
+
+    auto getCellValue = [&](int, int) -> char {
+        return itoc(maxColor);
+        };
+
+    if (paint)
+        paintResultsArea(mat, colors, cellCond);
+    else {
+        if (crop) {
+            fWriteCropped(filename,
+                          n, m,
+                          regions.box(maxRegion),
+                          cellCond,
+                          getCellValue,
+                          algo
+                         );
+        }
+        else {
+            const string fpath = updatePath(filename, maxSize, maxColor, algo);
+            // max region cells hold maxColor, so the matrix row itself is written under the mask
+            fWriteRows(fpath, n, m, [&](int r, uint8_t *mask) {
+                const auto *rowLabels = labels.data() + static_cast<size_t>(r) * m;
+                for (int c = 0; c < m; c++)
+                    mask[c] = rowLabels[c] == maxLabel;
+                return mat.row(r);
+            });
+        }
+    }
+
+    // final labels are region indices + 1
+    fWriteImage(algo, [&](int r, Cell *cells, uint8_t *mask, int32_t *region) {
+        const auto *rowLabels = labels.data() + static_cast<size_t>(r) * m;
+        for (int c = 0; c < m; c++)
+            mask[c] = rowLabels[c] == maxLabel;
+        if (region) {
+            for (int c = 0; c < m; c++)
+                region[c] = rowLabels[c] - 1;
+        }
+        copy(mat.row(r), mat.row(r) + m, cells);
+    });
+
+    displayMaxSize(algo);
+    fWriteRegions(algo);
+
+    return maxSize;
+}
+
+int CclColorGrid::newLabel(Cell color) {
+    const int label = static_cast<int>(equivalences.size());
+    equivalences.emplace_back(label);
+    labelColors.emplace_back(color);
+    return label;
+}
+
+int CclColorGrid::findRoot(int label) const {
+    while (equivalences[label] < label)
+        label = equivalences[label];
+    return label;
+}
+
+// point every label on the path to root (path compression)
+void CclColorGrid::setRoot(int label, int root) {
+    while (equivalences[label] < label) {
+        int parent = equivalences[label];
+        equivalences[label] = root;
+        label = parent;
+    }
+    equivalences[label] = root;
+}
+
+// the smaller label becomes the root, keeping equivalences[i] <= i
+int CclColorGrid::merge(int label1, int label2) {
+    int root = findRoot(label1);
+    if (label1 != label2) {
+        int root2 = findRoot(label2);
+        if (root > root2)
+            root = root2;
+        setRoot(label2, root);
+    }
+    setRoot(label1, root);
+    return root;
+}
+
+// 1st pass: decision tree over the visited neighbors
+//    NW  N  NE
+//    W   x
+// N touches NW, NE and W, so when N matches x it already carries their equivalence;
+// only NE may join a region through NW or W that it is not adjacent to.
+// Out-of-matrix neighbors fall into the sentinel border, which never matches.
+void CclColorGrid::labelingPass(const Grid &mat) {
+    labels.assign(static_cast<size_t>(n) * m, 0);
+    equivalences.assign(1, 0);  // label 0 is reserved
+    labelColors.assign(1, SENTINEL);
+
+    for (int r = 0; r < n; r++) {
+        const Cell *row = mat.row(r);
+        const Cell *up = mat.row(r - 1);
+        int *curr = labels.data() + static_cast<size_t>(r) * m;
+        const int *prev = curr - m;  // only dereferenced when up[] matches, i.e. r > 0
+
+        for (int c = 0; c < m; c++) {
+            const Cell value = row[c];
+            if (up[c] == value)
+                curr[c] = prev[c];
+            else if (up[c + 1] == value) {
+                if (up[c - 1] == value)
+                    curr[c] = merge(prev[c + 1], prev[c - 1]);
+                else if (row[c - 1] == value)
+                    curr[c] = merge(prev[c + 1], curr[c - 1]);
+                else
+                    curr[c] = prev[c + 1];
+            }
+            else if (up[c - 1] == value)
+                curr[c] = prev[c - 1];
+            else if (row[c - 1] == value)
+                curr[c] = curr[c - 1];
+            else
+                curr[c] = newLabel(value);
+        }
+    }
+}
+
+int CclColorGrid::flatten() {
+    int numOfRegions = 0;
+    for (int label = 1; label < static_cast<int>(equivalences.size()); label++) {
+        if (equivalences[label] < label) {
+            equivalences[label] = equivalences[equivalences[label]];
+        }
+        else {
+            equivalences[label] = ++numOfRegions;
+            regions.addRegion(labelColors[label]);
+        }
+    }
+    return numOfRegions;
+}
+
+#pragma warning(pop)
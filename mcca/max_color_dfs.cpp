@@ -28,7 +28,7 @@ int DfsColorGrid::calcMaxConnectedColor() {
     return 0;
 }
 
-int DfsColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat, 
+int DfsColorGrid::calcMaxConnectedColor(Grid &mat, 
                                         bool paint,
                                         bool colors, 
                                         const string &filepath, 
@@ -37,35 +37,41 @@ int DfsColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat,
     init(mat);
 
     int curr_max = 1;
-    vector<pair<int, int>> xy_coord_list;
+    int maxRegion = 0;
 
-    vector<vector<bool>> checked(n, vector<bool>(m, false));
-    set<pair<int, int>> coord_set;
+    const size_t maskWords = (static_cast<size_t>(n) * m + 63) / 64;
+    visited.assign(maskWords, 0);
+    maxSpans.clear();
 
     for (int row = 0; row < n; row++) {
         for (int col = 0; col < m; col++) {
-            int currValue = mat[row][col];
+            int currValue = mat(row, col);
             updateValueStats(currValue);
-            if (!checked[row][col]) {
-                vector<pair<int, int>> curr_xy_coord_list;
-                curr_max = dfs(mat, currValue, row, col, checked, curr_xy_coord_list);
-                if (maxSize < curr_max) {
+            if (!isVisited(row, col)) {
+                const int region = regions.addRegion(currValue);
+                curr_max = dfs(mat, currValue, row, col, currSpans, region);
+                // The first region is taken even at size 1 (as CCL, RUN & UF report it),
+                // so maxRegion, maxColor & maxSpans always describe an actual region
+                if (maxSize < curr_max || maxSpans.empty()) {
                     maxSize = curr_max;
-                    xy_coord_list = std::move(curr_xy_coord_list);
+                    swap(maxSpans, currSpans);
+                    maxRegion = region;
                     maxColor = currValue;
                 }
             }
         }
     }
 
-    for (const auto &coord : xy_coord_list) {
-        coord_set.insert(coord);
+    maxMask.assign(maskWords, 0);
+    for (const auto &[row, first, last] : maxSpans) {
+        for (int col = first; col <= last; col++)
+            setBit(maxMask, static_cast<size_t>(row) * m + col);
     }
 
     updateMfhFilename(filepath);
 
-    auto cellCond = [&coord_set](int r, int c) -> bool {
-        return coord_set.count(make_pair(r, c)) > 0;
+    auto cellCond = [this](int r, int c) -> bool {
+        return testBit(maxMask, static_cast<size_t>(r) * m + c);
         };
 
     auto getCellValue = [&](int r, int c) -> char {
@@ -78,6 +84,7 @@ int DfsColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat,
         if (crop) {
             fWriteCropped(filename,
                           n, m, 
+                          regions.box(maxRegion),
                           cellCond,
                           getCellValue,
                           algo
@@ -85,32 +92,95 @@ int DfsColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat,
         }
         else {
             const string filepath = updatePath(filename, maxSize, maxColor, algo);
-            fWriteAll(filepath,
-                      n, m,
-                      cellCond,
-                      getCellValue
-                     );
+            // max region cells hold maxColor, so the matrix row itself is written under the mask
+            fWriteRows(filepath, n, m, [&](int r, uint8_t *mask) {
+                const size_t rowCell = static_cast<size_t>(r) * m;
+                for (int c = 0; c < m; c++)
+                    mask[c] = testBit(maxMask, rowCell + c);
+                return mat.row(r);
+            });
         }
     } 
+
+    // DFS keeps no per-cell regions (only the max region mask), hence value colors only
+    fWriteImage(algo, [&](int r, Cell *cells, uint8_t *mask, int32_t *) {
+        const size_t rowCell = static_cast<size_t>(r) * m;
+        for (int c = 0; c < m; c++)
+            mask[c] = testBit(maxMask, rowCell + c);
+        copy(mat.row(r), mat.row(r) + m, cells);
+    }, false);
     
     displayMaxSize(algo);
+    fWriteRegions(algo);
 
     return maxSize;
 }
 
-int DfsColorGrid::dfs(vector<vector<int>> &mat, int curr_value, 
-                      int row, int col, vector<vector<bool>> &checked,
-                      vector<pair<int, int>> &coord_list) {
-    if (!isValid(row, col, n, m) || checked[row][col] || mat[row][col] != curr_value) {
-        return 0;
-    }
-    checked[row][col] = true;
-    coord_list.emplace_back(row, col);
-    int res = 1;
-    for (int i = 0; i < dr.size(); i++) {
-        int new_row = row + dr[i];
-        int new_col = col + dc[i];
-        res += dfs(mat, curr_value, new_row, new_col, checked, coord_list);
+bool DfsColorGrid::testBit(const vector<uint64_t> &bits, size_t idx) {
+    return (bits[idx >> 6] >> (idx & 63)) & 1;
+}
+
+void DfsColorGrid::setBit(vector<uint64_t> &bits, size_t idx) {
+    bits[idx >> 6] |= uint64_t(1) << (idx & 63);
+}
+
+bool DfsColorGrid::isVisited(int row, int col) const {
+    return testBit(visited, static_cast<size_t>(row) * m + col);
+}
+
+void DfsColorGrid::markVisited(int row, int col) {
+    setBit(visited, static_cast<size_t>(row) * m + col);
+}
+
+int DfsColorGrid::dfs(const Grid &mat, int curr_value, int row, int col,
+                      vector<Span> &spans, int region) {
+    // The sentinel border ends every run and scan before it leaves the matrix,
+    // so the visited bitset is only probed for in-range cells
+    auto isNew = [&](int r, int c) {
+        return mat(r, c) == curr_value && !isVisited(r, c);
+        };
+
+    spans.clear();
+    fillStack.clear();
+    fillStack.emplace_back(row, col);
+    int res = 0;
+
+    while (!fillStack.empty()) {
+        auto [r, c] = fillStack.back();
+        fillStack.pop_back();
+        if (isVisited(r, c))
+            continue;
+
+        // Extend the seed into its full horizontal run
+        const Cell *curr = mat.row(r);
+        int first = c, last = c;
+        while (curr[first - 1] == curr_value && !isVisited(r, first - 1))
+            first--;
+        while (curr[last + 1] == curr_value && !isVisited(r, last + 1))
+            last++;
+        for (int i = first; i <= last; i++)
+            markVisited(r, i);
+        spans.push_back({ r, first, last });
+        res += last - first + 1;
+
+        int boundaryCells = 0;
+        for (int i = first; i <= last; i++)
+            boundaryCells += RegionTable::isBoundaryCell(mat, r, i);
+        regions.addRun(region, r, first, last, boundaryCells);
+
+        // One seed per new run in the rows above & below, diagonals included
+        for (int adj : { r - 1, r + 1 }) {
+            bool inRun = false;
+            for (int i = first - 1; i <= last + 1; i++) {
+                if (isNew(adj, i)) {
+                    if (!inRun)
+                        fillStack.emplace_back(adj, i);
+                    inRun = true;
+                }
+                else
+                    inRun = false;
+            }
+        }
     }
     return res;
 }
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define MCCA_SSE2
+#endif
+
+#include <bit>
+#include <cstring>
+
+#pragma warning(push)
+#pragma warning(disable : 26495)  // Disable uninitialized variable warning (which occured despite a proper init within base class)
+
+#include "headers/max_color_run.hpp"
+
+namespace {
+    // set bits of bitmap in columns [lo, hi)
+    int popcountRange(const uint64_t *bitmap, int lo, int hi) {
+        int count = 0;
+        while (lo < hi) {
+            const int w = lo >> 6;
+            const int end = min(hi, (w + 1) << 6);
+            const uint64_t span = (~0ULL >> (64 - (end - lo))) << (lo & 63);
+            count += popcount(bitmap[w] & span);
+            lo = end;
+        }
+        return count;
+    }
+}
+
+RunColorGrid::RunColorGrid(MatFileHandler &handler) : CclColorGrid(handler) {}
+
+int RunColorGrid::calcMaxConnectedColor() {
+    return 0;
+}
+
+int RunColorGrid::calcMaxConnectedColor(Grid &mat,
+                                        bool paint,
+                                        bool colors,
+                                        const string &filepath,
+                                        bool crop) {
+    init(mat);
+
+    runs.clear();
+    rowStart.assign(1, 0);
+    equivalences.assign(1, 0);  // label 0 is reserved
+    labelColors.assign(1, SENTINEL);
+    eqW.assign((m + 63) / 64, 0);
+    inner.assign(eqW.size(), 0);
+
+    for (int r = 0; r < n; r++)
+        labelRow(mat, r);
+
+    const int numOfRegions = flatten();
+
+    // 2nd pass: replace provisional labels by final ones & accumulate region stats, a run at a time
+    for (int r = 0; r < n; r++) {
+        for (int i = rowStart[r]; i < rowStart[r + 1]; i++) {
+            Run &run = runs[i];
+            run.label = equivalences[run.label];
+            regions.addRun(run.label - 1, r, run.first, run.last, run.boundary);
+        }
+    }
+
+    // Final labels follow the raster order of each region's first cell,
+    // so the first max region found here is the same one DFS reports
+    int maxRegion = 0;
+    for (int region = 0; region < numOfRegions; region++) {
+        updateValueStats(regions.color[region]);
+        if (regions.size[region] > regions.size[maxRegion])
+            maxRegion = region;
+    }
+    const int maxLabel = maxRegion + 1;
+    maxSize = regions.size[maxRegion];
+    maxColor = regions.color[maxRegion];
+
+    updateMfhFilename(filepath);
+
+    auto cellCond = [&](int r, int c) -> bool {
+        return cellLabel(r, c) == maxLabel;
+        };
+
+    auto getCellValue = [&](int, int) -> char {
+        return itoc(maxColor);
+        };
+
+    if (paint)
+        paintResultsArea(mat, colors, cellCond);
+    else {
+        if (crop) {
+            fWriteCropped(filename,
+                          n, m,
+                          regions.box(maxRegion),
+                          cellCond,
+                          getCellValue,
+                          algo
+                         );
+        }
+        else {
+            const string fpath = updatePath(filename, maxSize, maxColor, algo);
+            // max region cells hold maxColor, so the matrix row itself is written under the mask
+            fWriteRows(fpath, n, m, [&](int r, uint8_t *mask) {
+                for (int i = rowStart[r]; i < rowStart[r + 1]; i++) {
+                    const Run &run = runs[i];
+                    memset(mask + run.first, run.label == maxLabel, run.last - run.first + 1);
+                }
+                return mat.row(r);
+            });
+        }
+    }
+
+    fWriteImage(algo, [&](int r, Cell *cells, uint8_t *mask, int32_t *region) {
+        for (int i = rowStart[r]; i < rowStart[r + 1]; i++) {
+            const Run &run = runs[i];
+            memset(mask + run.first, run.label == maxLabel, run.last - run.first + 1);
+            if (region)
+                fill(region + run.first, region + run.last + 1, run.label - 1);
+        }
+        copy(mat.row(r), mat.row(r) + m, cells);
+    });
+
+    displayMaxSize(algo);
+    fWriteRegions(algo);
+
+    return maxSize;
+}
+
+void RunColorGrid::rowMasks(const Grid &mat, int r, uint64_t *eqW, uint64_t *inner) {
+    const int cols = mat.cols();
+    const Cell *row = mat.row(r), *up = mat.row(r - 1), *down = mat.row(r + 1);
+    const int words = (cols + 63) / 64;
+    fill(eqW, eqW + words, 0);
+    fill(inner, inner + words, 0);
+    int c = 0;
+
+#if defined(__AVX2__)
+    for (; c + 32 <= cols; c += 32) {
+        const __m256i curr = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + c));
+        const __m256i west = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(row + c - 1));
+        const __m256i north = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(up + c));
+        const __m256i south = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(down + c));
+        const uint32_t w = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(curr, west)));
+        const uint32_t ns = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(curr, north), _mm256_cmpeq_epi8(curr, south))));
+        eqW[c >> 6] |= static_cast<uint64_t>(w) << (c & 63);
+        inner[c >> 6] |= static_cast<uint64_t>(ns) << (c & 63);
+    }
+#elif defined(MCCA_SSE2)
+    for (; c + 16 <= cols; c += 16) {
+        const __m128i curr = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + c));
+        const __m128i west = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row + c - 1));
+        const __m128i north = _mm_loadu_si128(reinterpret_cast<const __m128i *>(up + c));
+        const __m128i south = _mm_loadu_si128(reinterpret_cast<const __m128i *>(down + c));
+        const uint32_t w = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(curr, west)));
+        const uint32_t ns = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(curr, north), _mm_cmpeq_epi8(curr, south))));
+        eqW[c >> 6] |= static_cast<uint64_t>(w) << (c & 63);
+        inner[c >> 6] |= static_cast<uint64_t>(ns) << (c & 63);
+    }
+#endif
+
+    for (; c < cols; c++) {
+        eqW[c >> 6] |= static_cast<uint64_t>(row[c] == row[c - 1]) << (c & 63);
+        inner[c >> 6] |= static_cast<uint64_t>(row[c] == up[c] && row[c] == down[c]) << (c & 63);
+    }
+}
+
+// Runs start where a cell differs from its W neighbor (column 0 always does: the border is a sentinel).
+// Run J of row r & run I of row r - 1 are 8-connected iff they share the color and
+// I.first <= J.last + 1 && I.last >= J.first - 1 (overlap, or touching diagonally).
+void RunColorGrid::labelRow(const Grid &mat, int r) {
+    const Cell *row = mat.row(r), *up = mat.row(r - 1);
+    rowMasks(mat, r, eqW.data(), inner.data());
+
+    const int prevBegin = (r > 0) ? rowStart[r - 1] : 0, prevEnd = rowStart[r];
+    for (int w = 0; w < static_cast<int>(eqW.size()); w++) {
+        uint64_t starts = ~eqW[w];
+        if (w == static_cast<int>(eqW.size()) - 1 && (m & 63))
+            starts &= ~0ULL >> (64 - (m & 63));
+        while (starts) {
+            const int c = (w << 6) + countr_zero(starts);
+            starts &= starts - 1;
+            if (runs.size() > static_cast<size_t>(prevEnd))
+                runs.back().last = c - 1;
+            runs.push_back({ c, m - 1, 0, 0 });
+        }
+    }
+
+    int i = prevBegin;
+    for (int j = prevEnd; j < static_cast<int>(runs.size()); j++) {
+        Run &run = runs[j];
+        const Cell value = row[run.first];
+
+        // the run's end cells are always boundary cells, its interior ones unless N & S match
+        run.boundary = (run.last > run.first) ? 2 : 1;
+        if (run.last - run.first > 1)
+            run.boundary += (run.last - run.first - 1) - popcountRange(inner.data(), run.first + 1, run.last);
+
+        while (i < prevEnd && runs[i].last < run.first - 1)
+            i++;
+        for (int k = i; k < prevEnd && runs[k].first <= run.last + 1; k++) {
+            if (up[runs[k].first] != value)
+                continue;
+            run.label = run.label ? merge(run.label, runs[k].label) : runs[k].label;
+        }
+        if (!run.label)
+            run.label = newLabel(value);
+    }
+    rowStart.push_back(static_cast<int>(runs.size()));
+}
+
+int RunColorGrid::cellLabel(int r, int c) const {
+    const auto rowBegin = runs.begin() + rowStart[r], rowEnd = runs.begin() + rowStart[r + 1];
+    const auto run = upper_bound(rowBegin, rowEnd, c, [](int col, const Run &run) { return col < run.first; });
+    return prev(run)->label;
+}
+
+#pragma warning(pop)
@@ -20,64 +20,132 @@
 #pragma warning(push)
 #pragma warning(disable : 26495)  // Disable uninitialized variable warning (which occured despite a proper init within base class)
 
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
 #include "headers/max_color_uf.hpp"
 
+namespace {
+    // Streams dot text into an ofstream in VIS_DOT_CHUNK_BYTES chunks (no per-token stream formatting)
+    class DotBuffer {
+    public:
+        explicit DotBuffer(ofstream &file) : file(file) { text.reserve(VIS_DOT_CHUNK_BYTES + 256); }
+        ~DotBuffer() { flush(); }
+
+        DotBuffer &operator<<(const char *str) {
+            text += str;
+            return *this;
+        }
+
+        DotBuffer &operator<<(char ch) {
+            text += ch;
+            if (ch == '\n' && text.size() >= VIS_DOT_CHUNK_BYTES)
+                flush();
+            return *this;
+        }
+
+        DotBuffer &operator<<(int value) {
+            char digits[16];
+            text.append(digits, to_chars(digits, digits + sizeof(digits), value).ptr);
+            return *this;
+        }
+
+        DotBuffer &operator<<(double value) {
+            char digits[32];
+            text.append(digits, to_chars(digits, digits + sizeof(digits), value, chars_format::fixed, 2).ptr);
+            return *this;
+        }
+
+        void flush() {
+            file.write(text.data(), static_cast<streamsize>(text.size()));
+            text.clear();
+        }
+
+    private:
+        ofstream &file;
+        string text;
+    };
+
+    const char *fontColorOn(const char *fillColor) {
+        return (!strcmp(fillColor, "blue")) ? "white" : "black";
+    }
+}
+
 UnionFindColorGrid::UnionFindColorGrid(MatFileHandler &handler) : ColorGrid(handler) {
     maxColorSet.clear();       // track max color codes
     colorRegionsMap.clear();  // track regions for each color
     visualizerEn = false;
     imageFormat = "svg";
+    visMode = DEFAULT_VIS_MODE;
+    ufPolicy = DEFAULT_UF_POLICY;
+    threads = DEFAULT_THREADS;
 }
 
 int UnionFindColorGrid::calcMaxConnectedColor() {
     return 0;
 }
 
-int UnionFindColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat,
+int UnionFindColorGrid::calcMaxConnectedColor(Grid &mat,
                                               bool paint, bool colors,
                                               const string &filepath,
                                               bool crop) {
     init(mat);
+    return solve(mat, paint, colors, filepath, crop);
+}
 
-    UnionFind uf(n * m);
-
-    int currentRegionSize = 1;
-
-    // To track the pairs already united
-    unordered_set<pair<int, int>, hash_pair> loggedPairs;
+int UnionFindColorGrid::calcMaxConnectedColor(const PackedGrid &mat,
+                                              bool paint, bool colors,
+                                              const string &filepath,
+                                              bool crop) {
+    init(mat);
+    return solve(mat, paint, colors, filepath, crop);
+}
 
-    for (int row = 0; row < n; row++) {
-        for (int col = 0; col < m; col++) {
-            int currCell = row * m + col;
-            int currValue = mat[row][col];
-            updateValueStats(currValue);
-            processAdjCells(row, col, mat, currCell, currValue, uf, loggedPairs);
-            int root = uf.find(currCell);
-            currentRegionSize = uf.size[root];
-            if (currentRegionSize > maxSize) {
-                maxSize = currentRegionSize;              
-                maxColorSet = { currValue };  // Start a new set with the color code of the new max-size root
-                colorRegionsMap.clear();  // Clear old regions map when we find a new maxSize
-                colorRegionsMap[currValue].insert(root);
-            }
-            else if (currentRegionSize == maxSize) {
-                // Add color code to the set if it's not already there
-                maxColorSet.insert(currValue);
-                colorRegionsMap[currValue].insert(root);  // Add the root to the regions map
-            }
-        }
+template <typename Matrix>
+int UnionFindColorGrid::solve(const Matrix &mat, bool paint, bool colors,
+                              const string &filepath, bool crop) {
+    if (ufPolicy == "COMPRESS") {
+        CompressUnionFind uf(n * m);
+        return solveWith(uf, mat, paint, colors, filepath, crop);
+    }
+    if (ufPolicy == "SPLITTING") {
+        SplittingUnionFind uf(n * m);
+        return solveWith(uf, mat, paint, colors, filepath, crop);
+    }
+    if (ufPolicy == "REM") {
+        RemUnionFind uf(n * m);
+        return solveWith(uf, mat, paint, colors, filepath, crop);
+    }
+    if (ufPolicy == "LOCKFREE") {
+        ConcurrentUnionFind uf(n * m);
+        return solveWith(uf, mat, paint, colors, filepath, crop);
     }
+    HalvingUnionFind uf(n * m);
+    return solveWith(uf, mat, paint, colors, filepath, crop);
+}
+
+template <typename UF, typename Matrix>
+int UnionFindColorGrid::solveWith(UF &uf, const Matrix &mat, bool paint, bool colors,
+                                  const string &filepath, bool crop) {
+    if constexpr (is_same_v<UF, ConcurrentUnionFind>)
+        labelShared(uf, mat);
+    else
+        labelStrips(uf, mat);
 
-    maxColor = *maxColorSet.begin();
+    flattenRegions(mat, uf);
+    collectMaxRegions();
     
     updateMfhFilename(filepath);
 
     if (visualizerEn) {
-        if (max(m, n) <= VIS_MAT_THR){
+        if (visMode == "condensed" || max(m, n) <= VIS_MAT_THR){
             ostringstream oss;
             oss << "Visualizer activated!\n";
             formatTxt(oss, LIGHT_MAGENTA);
-            visualizeUF(uf, maxSize, filename);
+            visualizeUF(maxSize, filename);
         }
         else
             formatTxt(getErrMsg(ErrCode::GRAPHVIZ_MAT_LIMIT, ErrorContext()), LIGHT_MAGENTA);
@@ -85,39 +153,60 @@ int UnionFindColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat,
 
     bool extraInfoFile = false; 
 
-    auto cellCond = [&](int r, int c) -> int {
-        return uf.getSize(r * m + c) == maxSize;
+    auto cellCond = [&](int r, int c) -> bool {
+        return regions.size[cellRegion[r * m + c]] == maxSize;
     };
 
     auto getCellValue = [&](int r, int c) -> char {
-        return itoc(mat[r][c]);
+        return itoc(mat(r, c));
     };
 
     if (paint) {
-        paintResultsArea(mat, colors, cellCond);                   
+        if constexpr (is_same_v<Matrix, PackedGrid>)
+            paintResultsArea(mat.unpack(), colors, cellCond);
+        else
+            paintResultsArea(mat, colors, cellCond);
     }
     else {
         if (crop) {
             fWriteCropped(filename,
-                          uf,
-                          mat, 
                           n, m,
-                          cellCond,
                           getCellValue
                          );
         }
         else {
             const string fpath = updatePath(filename, maxSize, maxColor, algo);
-            fWriteAll(fpath,
-                      n, m,
-                      cellCond,
-                      getCellValue
-                     );
+            vector<Cell> unpackedRow;
+            fWriteRows(fpath, n, m, [&](int r, uint8_t *mask) -> const Cell * {
+                const int32_t *rowRegions = cellRegion.data() + static_cast<size_t>(r) * m;
+                for (int c = 0; c < m; c++)
+                    mask[c] = regions.size[rowRegions[c]] == maxSize;
+                if constexpr (is_same_v<Matrix, PackedGrid>) {
+                    unpackedRow.resize(m);
+                    mat.unpackRow(r, unpackedRow.data());
+                    return unpackedRow.data();
+                }
+                else
+                    return mat.row(r);
+            });
         }
         extraInfoFile = true;
     }
 
+    fWriteImage(algo, [&](int r, Cell *cells, uint8_t *mask, int32_t *region) {
+        const int32_t *rowRegions = cellRegion.data() + static_cast<size_t>(r) * m;
+        for (int c = 0; c < m; c++)
+            mask[c] = regions.size[rowRegions[c]] == maxSize;
+        if (region)
+            copy(rowRegions, rowRegions + m, region);
+        if constexpr (is_same_v<Matrix, PackedGrid>)
+            mat.unpackRow(r, cells);
+        else
+            copy(mat.row(r), mat.row(r) + m, cells);
+    });
+
     displayMaxSize(algo);
+    fWriteRegions(algo);
 
     if (maxColorSet.size() > 1)
         notifyMaxColorRegions(filename, maxSize, maxColorSet, colorRegionsMap, extraInfoFile);
@@ -125,8 +214,7 @@ int UnionFindColorGrid::calcMaxConnectedColor(vector<vector<int>> &mat,
     return maxSize;
 }
 
-void UnionFindColorGrid::visualizeUF(UnionFind &uf,
-                                     int maxSize,
+void UnionFindColorGrid::visualizeUF(int maxSize,
                                      const string &filename,
                                      bool show) {
     // Prerequisites: Graphviz, configured as system env variable.
@@ -137,35 +225,21 @@ void UnionFindColorGrid::visualizeUF(UnionFind &uf,
 
     string filePathStr = filePath.str();
 
-    outFilePath << filePathStr << "_UFtree." << imageFormat; 
+    const string graphName = (visMode == "condensed") ? "_regions." : "_UFtree.";
+
+    outFilePath << filePathStr << graphName << imageFormat; 
 
-    dotFilePath << filePathStr + "_UFtree.dot";
+    dotFilePath << filePathStr << graphName << "dot";
 
     string dotFilePathStr = dotFilePath.str();
 
     string outFilePathStr = outFilePath.str();
 
-    ofstream dotFile(dotFilePathStr);
-    dotFile << "digraph UnionFindTree {\n";
-
-    // Node attributes based on their color
-    for (int i = 0; i < uf.parent.size(); ++i) {
-        int root = uf.find(i);
-        const char *color = getRegionColor(root, colorRegionsMap);
-        const char *fontcolor = (!strcmp(color, "blue")) ? "white" : "black";
-
-        dotFile << "    " << i << " [style=filled, fillcolor=\"" << color
-                << "\", fontcolor=\"" << fontcolor << "\"];\n";
-    }
-
-    for (int i = 0; i < uf.parent.size(); ++i) {
-        int root = uf.find(i);
-        if (root != i) {
-            dotFile << "    " << i << " -> " << root << ";\n";
-        }
-    }
-
-    dotFile << "}\n";
+    ofstream dotFile(dotFilePathStr, ios::binary);
+    if (visMode == "condensed")
+        writeCondensedDot(dotFile);
+    else
+        writeTreeDot(dotFile);
     dotFile.close();
 
     // Render an image from a dot file
@@ -201,7 +275,7 @@ void UnionFindColorGrid::visualizeUF(UnionFind &uf,
 // Notify extra max colors regions (unique method for UF algorithm)
 // Useful for multiple equally-sized max regions with different color codes 
 void UnionFindColorGrid::notifyMaxColorRegions(const string &filename, int maxSize,
-                                               const unordered_set<int> &maxColorSet,
+                                               const set<int> &maxColorSet,
                                                const unordered_map<int, 
                                                unordered_set<int>> &colorRegionsMap, 
                                                bool extraFile) {
@@ -215,79 +289,325 @@ void UnionFindColorGrid::notifyMaxColorRegions(const string &filename, int maxSi
     formatTxt(oss, LIGHT_CYAN);
 
     if (extraFile)
-        fWrite(oss.str(), 
-               updatePath(filename, maxSize, algo),
-               "additional info file", true);
+        mfh.writer.submit(oss.str(),
+                          updatePath(filename, maxSize, algo),
+                          "additional info file", true);
+}
+
+void UnionFindColorGrid::writeTreeDot(ofstream &dotFile) const {
+    // Fill color per region, looked up once instead of per cell
+    vector<const char *> fillColor(regions.count(), "white");
+    for (int region : maxRegions)
+        fillColor[region] = getGraphvizColorFromKey(regions.color[region]);
+
+    DotBuffer dot(dotFile);
+    dot << "digraph UnionFindTree {\n";
+
+    // Node attributes based on their color
+    for (int i = 0; i < n * m; ++i) {
+        const char *color = fillColor[cellRegion[i]];
+        dot << "    " << i << " [style=filled, fillcolor=\"" << color
+            << "\", fontcolor=\"" << fontColorOn(color) << "\"];" << '\n';
+    }
+
+    for (int i = 0; i < n * m; ++i) {
+        const int root = regionRoot[cellRegion[i]];
+        if (root != i)
+            dot << "    " << i << " -> " << root << ";" << '\n';
+    }
+
+    dot << "}" << '\n';
 }
 
-const char *UnionFindColorGrid::getRegionColor(int root, 
-                                               const unordered_map<int, unordered_set<int>>& colorRegionsMap) const {
-    for (const auto &[colorCode, regions] : colorRegionsMap) {
-        if (regions.find(root) != regions.end()) {
-            return getGraphvizColorFromKey(colorCode);
+// Regions sharing an edge are adjacent. Regions touching only at a corner are left unlinked:
+// the two cells between them belong to other regions, each bordering both.
+// The adjacent pairs of each row are deduplicated on the fly (sort & unique whenever the pair
+// list doubles), keeping memory in O(edges) rather than O(boundary cells).
+void UnionFindColorGrid::writeCondensedDot(ofstream &dotFile) const {
+    vector<uint64_t> edges;
+    size_t compactAt = 1 << 16;
+    auto addEdge = [&](uint32_t a, uint32_t b) {
+        const uint64_t edge = (a < b) ? (uint64_t(a) << 32 | b) : (uint64_t(b) << 32 | a);
+        if (edges.empty() || edges.back() != edge)
+            edges.push_back(edge);
+    };
+    auto compact = [&]() {
+        sort(edges.begin(), edges.end());
+        edges.erase(unique(edges.begin(), edges.end()), edges.end());
+    };
+
+    for (int row = 0; row < n; row++) {
+        const int32_t *curr = cellRegion.data() + static_cast<size_t>(row) * m;
+        const int32_t *down = curr + m;
+        for (int col = 0; col + 1 < m; col++) {
+            if (curr[col] != curr[col + 1])
+                addEdge(curr[col], curr[col + 1]);
+        }
+        if (row + 1 < n) {
+            for (int col = 0; col < m; col++) {
+                if (curr[col] != down[col])
+                    addEdge(curr[col], down[col]);
+            }
+        }
+        if (edges.size() >= compactAt) {
+            compact();
+            compactAt = max(compactAt, 2 * edges.size());
         }
     }
-    return "white";
+    compact();
+
+    DotBuffer dot(dotFile);
+    dot << "graph Regions {\n"
+        << "    graph [layout=sfdp, overlap=prism, outputorder=edgesfirst];\n"
+        << "    node [shape=circle, style=filled, fixedsize=true, fontsize=8];\n";
+
+    // Node area proportional to the region size; max regions outlined
+    for (int region = 0; region < regions.count(); region++) {
+        const int size = regions.size[region];
+        const char *color = getGraphvizColorFromKey(regions.color[region]);
+        const double width = VIS_NODE_MIN_WIDTH +
+                              (VIS_NODE_MAX_WIDTH - VIS_NODE_MIN_WIDTH) * sqrt(double(size) / maxSize);
+        dot << "    " << region << " [label=\"" << size << "\", width=" << width
+            << ", fillcolor=\"" << color << "\", fontcolor=\"" << fontColorOn(color) << "\"";
+        if (size == maxSize)
+            dot << ", penwidth=3";
+        dot << "];" << '\n';
+    }
+
+    for (uint64_t edge : edges)
+        dot << "    " << int(edge >> 32) << " -- " << int(edge & 0xFFFFFFFF) << ";" << '\n';
+
+    dot << "}" << '\n';
 }
 
+// In raster order, every pair of 8-adjacent cells is met exactly once from its later cell,
+// so only the W, NW, N & NE neighbors can introduce new unions (no pair bookkeeping needed).
+// N is adjacent to NW, W & NE, hence a matching N already carries their unions;
+// likewise NW & W are adjacent, so a matching NW covers W.
+// Out-of-matrix neighbors fall into the sentinel border, which never matches.
+template <typename UF>
 void UnionFindColorGrid::processAdjCells(int row, int col,
-                                         vector<vector<int>> &matrix,
+                                         const Grid &matrix,
                                          int currCell,                                     
                                          int currValue,                                     
-                                         UnionFind &uf,
-                                         unordered_set<pair<int, int>, hash_pair> &loggedPairs
+                                         UF &uf
                                         ) {
-    for (int i = 0; i < dr.size(); i++) {
-        int newRow = row + dr[i];
-        int newCol = col + dc[i];
-        if (isValid(newRow, newCol, n, m) && matrix[newRow][newCol] == currValue) {
-            int adjCell = newRow * m + newCol;
-            pair<int, int> cellPair =
-                currCell < adjCell ? make_pair(currCell, adjCell) : make_pair(adjCell, currCell);
-            if (loggedPairs.find(cellPair) == loggedPairs.end()) {
-                uf.unite(currCell, adjCell);
-                loggedPairs.insert(cellPair);
+    const Cell *curr = matrix.row(row);
+    const Cell *up = matrix.row(row - 1);
+
+    if (up[col] == currValue) {
+        uf.unite(currCell, currCell - m);
+        return;
+    }
+    if (up[col + 1] == currValue)
+        uf.unite(currCell, currCell - m + 1);
+    if (up[col - 1] == currValue)
+        uf.unite(currCell, currCell - m - 1);
+    else if (curr[col - 1] == currValue)
+        uf.unite(currCell, currCell - 1);
+}
+
+// Label rows [firstRow, lastRow). Unless joinUpperRow is set, firstRow is only joined along
+// the row itself (W), leaving its N, NW & NE neighbors to a later boundary merge.
+template <typename UF>
+void UnionFindColorGrid::labelRows(UF &uf, const Grid &mat, int firstRow, int lastRow,
+                                   bool joinUpperRow, pair<int, int> &valueStats) {
+    auto &[minValue, maxValue] = valueStats;
+    for (int row = firstRow; row < lastRow; row++) {
+        const Cell *curr = mat.row(row);
+        for (int col = 0; col < m; col++) {
+            int currCell = row * m + col;
+            int currValue = curr[col];
+            minValue = min(minValue, currValue);
+            maxValue = max(maxValue, currValue);
+            if (row > firstRow || joinUpperRow)
+                processAdjCells(row, col, mat, currCell, currValue, uf);
+            else if (curr[col - 1] == currValue)
+                uf.unite(currCell, currCell - 1);
+        }
+    }
+}
+
+// Per word, the W, NW, N & NE equality masks come from nibble-wise XORs of the packed row
+// & the row above (shifted by one cell for the diagonals); cells without any matching
+// neighbor are skipped, the others replay processAdjCells' choices from the masks.
+// The min/max values were gathered while packing.
+template <typename UF>
+void UnionFindColorGrid::labelRows(UF &uf, const PackedGrid &mat, int firstRow, int lastRow,
+                                   bool joinUpperRow, pair<int, int> &valueStats) {
+    constexpr int WORD_CELLS = PackedGrid::CELLS_PER_WORD;
+    valueStats = { mat.minValue(), mat.maxValue() };
+    for (int row = firstRow; row < lastRow; row++) {
+        const uint64_t *curr = mat.row(row);
+        const uint64_t *up = mat.row(row - 1);
+        const bool joinUp = row > firstRow || joinUpperRow;
+        for (int w = 0; w < mat.wordsPerRow(); w++) {
+            const uint64_t eqW = PackedGrid::nibbleEq(curr[w], mat.westOf(curr, w));
+            uint64_t eqN = 0, eqNW = 0, eqNE = 0;
+            if (joinUp) {
+                eqN = PackedGrid::nibbleEq(curr[w], up[w]);
+                eqNW = PackedGrid::nibbleEq(curr[w], mat.westOf(up, w));
+                eqNE = PackedGrid::nibbleEq(curr[w], mat.eastOf(up, w));
+            }
+            const int rowCell = row * m + w * WORD_CELLS;
+            for (uint64_t pending = (eqW | eqN | eqNW | eqNE) & mat.validMask(w); pending;
+                 pending &= pending - 1) {
+                const int nibble = countr_zero(pending);
+                const uint64_t bit = uint64_t(1) << nibble;
+                const int currCell = rowCell + nibble / 4;
+                if (eqN & bit) {
+                    uf.unite(currCell, currCell - m);
+                    continue;
+                }
+                if (eqNE & bit)
+                    uf.unite(currCell, currCell - m + 1);
+                if (eqNW & bit)
+                    uf.unite(currCell, currCell - m - 1);
+                else if (eqW & bit)
+                    uf.unite(currCell, currCell - 1);
             }
         }
     }
 }
 
+// Split the rows into horizontal strips, one per worker. Unions within a strip only touch
+// that strip's cells, so the workers share the UnionFind array without locking.
+// The first row of each strip is then merged with the row above it (N, NW, NE),
+// serially and in a fixed order. The resulting sets do not depend on the thread count.
+template <typename UF, typename Matrix>
+void UnionFindColorGrid::labelStrips(UF &uf, const Matrix &mat) {
+    const int numOfStrips = max(1, min(threads, n));
+    vector<pair<int, int>> valueStats(numOfStrips, { INT_MAX, INT_MIN });
+
+    auto stripRow = [&](int strip) {
+        return static_cast<int>(static_cast<long long>(n) * strip / numOfStrips);
+    };
+
+    auto labelStrip = [&](int strip) {
+        labelRows(uf, mat, stripRow(strip), stripRow(strip + 1), strip == 0, valueStats[strip]);
+    };
+
+    vector<thread> workers;
+    workers.reserve(numOfStrips - 1);
+    for (int strip = 1; strip < numOfStrips; strip++)
+        workers.emplace_back(labelStrip, strip);
+    labelStrip(0);
+    for (auto &worker : workers)
+        worker.join();
+
+    // Merge across strip boundaries (including the diagonals)
+    pair<int, int> boundaryStats = { INT_MAX, INT_MIN };
+    for (int strip = 1; strip < numOfStrips; strip++)
+        labelRows(uf, mat, stripRow(strip), stripRow(strip) + 1, true, boundaryStats);
+
+    for (const auto &[minValue, maxValue] : valueStats) {
+        updateValueStats(minValue);
+        updateValueStats(maxValue);
+    }
+}
+
+// All workers unite straight into the shared lock-free structure, pulling row chunks
+// in any order - no strips and no boundary merge.
+template <typename Matrix>
+void UnionFindColorGrid::labelShared(ConcurrentUnionFind &uf, const Matrix &mat) {
+    const int numOfWorkers = max(1, min(threads, n));
+    vector<pair<int, int>> valueStats(numOfWorkers, { INT_MAX, INT_MIN });
+    atomic<int> nextRow(0);
+
+    auto labelChunks = [&](int worker) {
+        for (int firstRow = nextRow.fetch_add(SHARED_ROW_CHUNK); firstRow < n;
+             firstRow = nextRow.fetch_add(SHARED_ROW_CHUNK)) {
+            labelRows(uf, mat, firstRow, min(n, firstRow + SHARED_ROW_CHUNK), true, valueStats[worker]);
+        }
+    };
+
+    vector<thread> workers;
+    workers.reserve(numOfWorkers - 1);
+    for (int worker = 1; worker < numOfWorkers; worker++)
+        workers.emplace_back(labelChunks, worker);
+    labelChunks(0);
+    for (auto &worker : workers)
+        worker.join();
+
+    uf.finalize(numOfWorkers);
+
+    for (const auto &[minValue, maxValue] : valueStats) {
+        if (minValue > maxValue)  // idle worker (fewer row chunks than workers)
+            continue;
+        updateValueStats(minValue);
+        updateValueStats(maxValue);
+    }
+}
+
+template <typename UF, typename Matrix>
+void UnionFindColorGrid::flattenRegions(const Matrix &matrix, UF &uf) {
+    const int numOfCells = n * m;
+
+    regionRoot.clear();
+    regions.clear();
+    cellRegion.assign(numOfCells, -1);
+
+    // Regions are numbered as the sweep first reaches them (raster order of their first cell, as in
+    // DFS, CCL & RUN), whatever the union order; a root's entry holds its region from then on,
+    // before the root cell itself is swept if it comes later
+    for (int row = 0, cell = 0; row < n; row++) {
+        const int32_t *rowRegions = cellRegion.data() + cell;
+        for (int col = 0; col < m; col++, cell++) {
+            const int root = uf.find(cell);
+            if (cellRegion[root] < 0) {
+                cellRegion[root] = regions.addRegion(matrix(row, col));
+                regionRoot.push_back(root);
+            }
+            cellRegion[cell] = cellRegion[root];
+        }
+        regions.addRow(matrix, row, rowRegions);
+    }
+}
+
+void UnionFindColorGrid::collectMaxRegions() {
+    const int numOfRegions = regions.count();
+
+    maxSize = 0;
+    for (int size : regions.size)
+        maxSize = max(maxSize, size);
+
+    maxRegions.clear();
+    maxColorSet.clear();
+    colorRegionsMap.clear();
+    for (int region = 0; region < numOfRegions; region++) {
+        if (regions.size[region] == maxSize) {
+            maxRegions.push_back(region);
+            maxColorSet.insert(regions.color[region]);
+            colorRegionsMap[regions.color[region]].insert(regionRoot[region]);
+        }
+    }
+    // Cropped files are written per color code, in ascending order
+    stable_sort(maxRegions.begin(), maxRegions.end(),
+                [&](int a, int b) { return regions.color[a] < regions.color[b]; });
+
+    // Report the max region whose first cell comes first in raster order (as DFS does)
+    maxColor = regions.color[*min_element(maxRegions.begin(), maxRegions.end())];
+}
+
 //For --crop option (only write each bounding box of equally-sized max region to separate file)
 void UnionFindColorGrid::fWriteCropped(const string &filename,
-                                       UnionFind &uf,
-                                       vector<vector<int>> &mat,
                                        int n, int m,
-                                       const function<bool(int, int)> &cellCondition,
                                        const function<char(int, int)> &getCellValue
                                       ) {
+    for (int region : maxRegions) {
+        auto regionCond = [&](int r, int c) -> bool {
+            return cellRegion[r * m + c] == region;
+            };
 
-    // Iterate through all color codes in maxColorSet
-    for (int colorCode : maxColorSet) {
-        // Iterate through all regions corresponding to this color code
-        const auto &regions = colorRegionsMap.at(colorCode);
-        for (int root : regions) {
-
-            auto regionCond = [&](int r, int c) -> int {
-                int cell = r * m + c;
-                return uf.find(cell) == root && cellCondition(r, c);
-                };
-
-            auto compositeCond = [&](int r, int c) -> bool {
-                return regionCond(r, c) && (mat[r][c] == colorCode);
-                };
-
-            int minRow = n, maxRow = -1, minCol = m, maxCol = -1;
-            calcBoundingBox(minRow, maxRow, minCol,
-                            maxCol, n, m, regionCond);
-
-            // Construct a unique file name based on the bounding box coordinates
-            const string filepath = updatePath(filename, colorCode, minRow,
-                                               alignCol(minCol), maxRow,
-                                               alignCol(maxCol), algo);
-
-            fWriteResults(filepath, n, m, compositeCond, getCellValue,
-                          true, minRow, maxRow, minCol, maxCol);
-        }
+        auto [minRow, maxRow, minCol, maxCol] = regions.box(region);
+
+        // Construct a unique file name based on the bounding box coordinates
+        const string filepath = updatePath(filename, regions.color[region], minRow,
+                                           alignCol(minCol), maxRow,
+                                           alignCol(maxCol), algo);
+
+        fWriteResults(filepath, n, m, regionCond, getCellValue,
+                      true, minRow, maxRow, minCol, maxCol);
     }
 }
 #pragma warning(pop)
\ No newline at end of file
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#include <climits>
+#include <iomanip>
+#include <sstream>
+
+#include "headers/region_table.hpp"
+
+void RegionTable::clear() {
+    for (auto *column : { &size, &color, &minRow, &maxRow, &minCol, &maxCol, &boundary })
+        column->clear();
+    rowSum.clear();
+    colSum.clear();
+}
+
+int RegionTable::addRegion(int colorCode) {
+    size.push_back(0);
+    color.push_back(colorCode);
+    minRow.push_back(INT_MAX);
+    maxRow.push_back(-1);
+    minCol.push_back(INT_MAX);
+    maxCol.push_back(-1);
+    rowSum.push_back(0);
+    colSum.push_back(0);
+    boundary.push_back(0);
+    return count() - 1;
+}
+
+BoundingBox RegionTable::box(int region) const {
+    return { minRow[region], maxRow[region], minCol[region], maxCol[region] };
+}
+
+double RegionTable::centroidRow(int region) const {
+    return static_cast<double>(rowSum[region]) / size[region];
+}
+
+double RegionTable::centroidCol(int region) const {
+    return static_cast<double>(colSum[region]) / size[region];
+}
+
+string RegionTable::toCsv() const {
+    ostringstream oss;
+    oss << fixed << setprecision(3);
+    oss << "region,size,color,min_row,min_col,max_row,max_col,centroid_row,centroid_col,boundary_cells\n";
+    for (int region = 0; region < count(); region++) {
+        oss << region << "," << size[region] << "," << color[region] << ","
+            << minRow[region] << "," << minCol[region] << ","
+            << maxRow[region] << "," << maxCol[region] << ","
+            << centroidRow(region) << "," << centroidCol(region) << ","
+            << boundary[region] << "\n";
+    }
+    return oss.str();
+}
+
+string RegionTable::toJson() const {
+    ostringstream oss;
+    oss << fixed << setprecision(3);
+    oss << "[\n";
+    for (int region = 0; region < count(); region++) {
+        oss << "  {\"region\": " << region
+            << ", \"size\": " << size[region]
+            << ", \"color\": " << color[region]
+            << ", \"bbox\": [" << minRow[region] << ", " << minCol[region] << ", "
+            << maxRow[region] << ", " << maxCol[region] << "]"
+            << ", \"centroid\": [" << centroidRow(region) << ", " << centroidCol(region) << "]"
+            << ", \"boundary_cells\": " << boundary[region] << "}"
+            << (region + 1 < count() ? ",\n" : "\n");
+    }
+    oss << "]\n";
+    return oss.str();
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (C) 2025 Yaron Dayan
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * Attribution Notice:
+ * The original author, Yaron Dayan, must be credited in all derivative works.
+ */
+
+#pragma warning(push)
+#pragma warning(disable : 26495)  // Disable uninitialized variable warning (which occured despite a proper init within base class)
+
+#include "headers/stream_color_grid.hpp"
+
+StreamColorGrid::StreamColorGrid(MatFileHandler &handler) :
+    ColorGrid(handler), maxRegionSize(0), maxBox{}, maxFirstCell(0) {}
+
+int StreamColorGrid::calcMaxConnectedColor() {
+    return 0;
+}
+
+bool StreamColorGrid::calcMaxConnectedColor(const string &filepath) {
+    if (isMccbFile(filepath)) {
+        MccbRowReader reader(filepath);
+        if (!reader.isOpen())
+            return false;
+        return labelStream([&](vector<Cell> &row) { return reader.nextRow(row); },
+                           [&] { return reader.failed(); });
+    }
+
+    MatRowReader reader(filepath);
+    if (!reader.isOpen()) {
+        handleError(ErrCode::FILE_OPEN_ERROR, ErrorContext());
+        return false;
+    }
+    return labelStream([&](vector<Cell> &row) { return reader.nextRow(row); },
+                       [&] { return reader.failed(); });
+}
+
+template <typename NextRow, typename Failed>
+bool StreamColorGrid::labelStream(NextRow nextRow, Failed failed) {
+    maxRegionSize = 0;
+    maxFirstCell = INT64_MAX;
+    maxBox = {};
+    parent.assign(1, 0);
+    size.assign(1, 0);
+    firstCell.assign(1, 0);
+    color.assign(1, SENTINEL);
+    box.assign(1, {});
+    seenRow.assign(1, -1);
+    liveLabels.clear();
+    freeLabels.clear();
+
+    vector<Cell> row;
+    int r = 0;
+    while (nextRow(row)) {
+        if (r == 0) {
+            m = static_cast<int>(row.size());
+            prevRow.assign(m + 2, SENTINEL);
+            currRow.assign(m + 2, SENTINEL);
+            prevLabels.assign(m + 2, 0);
+            currLabels.assign(m + 2, 0);
+        }
+        copy(row.begin(), row.end(), currRow.begin() + 1);
+        labelRow(r);
+        recycleLabels(r);
+        swap(prevRow, currRow);
+        swap(prevLabels, currLabels);
+        r++;
+    }
+    if (failed())
+        return false;
+
+    // Whatever is still open reaches the last row
+    for (int label : liveLabels)
+        closeComponent(label);
+
+    n = r;
+    maxSize = static_cast<int>(min<int64_t>(maxRegionSize, INT_MAX));
+    displayMaxRegion();
+    return true;
+}
+
+int StreamColorGrid::newLabel(Cell value, int row, int col) {
+    int label;
+    if (freeLabels.empty()) {
+        label = static_cast<int>(parent.size());
+        parent.emplace_back();
+        size.emplace_back();
+        firstCell.emplace_back();
+        color.emplace_back();
+        box.emplace_back();
+        seenRow.emplace_back();
+    }
+    else {
+        label = freeLabels.back();
+        freeLabels.pop_back();
+    }
+    parent[label] = label;
+    size[label] = 0;
+    firstCell[label] = static_cast<int64_t>(row) * m + col;
+    color[label] = value;
+    box[label] = { row, row, col, col };
+    seenRow[label] = -1;
+    liveLabels.push_back(label);
+    return label;
+}
+
+int StreamColorGrid::find(int label) {
+    while (parent[label] != label) {
+        parent[label] = parent[parent[label]];  // path halving
+        label = parent[label];
+    }
+    return label;
+}
+
+int StreamColorGrid::unite(int label1, int label2) {
+    int root1 = find(label1);
+    int root2 = find(label2);
+    if (root1 == root2)
+        return root1;
+    if (size[root1] < size[root2])
+        swap(root1, root2);
+    parent[root2] = root1;
+    size[root1] += size[root2];
+    firstCell[root1] = min(firstCell[root1], firstCell[root2]);
+    auto &box1 = box[root1];
+    const auto &box2 = box[root2];
+    box1 = { min(box1.minRow, box2.minRow), max(box1.maxRow, box2.maxRow),
+             min(box1.minCol, box2.minCol), max(box1.maxCol, box2.maxCol) };
+    return root1;
+}
+
+// Same backward stencil as the UF engine: N covers NW, NE & W; otherwise NE joins NW or W
+void StreamColorGrid::labelRow(int row) {
+    const Cell *up = prevRow.data();
+    const Cell *curr = currRow.data();
+    const int *upLabels = prevLabels.data();
+    int *labels = currLabels.data();
+
+    for (int c = 1; c <= m; c++) {
+        const Cell value = curr[c];
+        updateValueStats(value);
+
+        int label = 0;
+        if (up[c] == value)
+            label = upLabels[c];
+        else {
+            if (up[c + 1] == value)
+                label = upLabels[c + 1];
+            if (up[c - 1] == value)
+                label = label ? unite(label, upLabels[c - 1]) : upLabels[c - 1];
+            else if (curr[c - 1] == value)
+                label = label ? unite(label, labels[c - 1]) : labels[c - 1];
+            if (!label)
+                label = newLabel(value, row, c - 1);
+        }
+
+        label = find(label);
+        labels[c] = label;
+        size[label]++;
+        auto &labelBox = box[label];
+        labelBox.maxRow = row;
+        labelBox.minCol = min(labelBox.minCol, c - 1);
+        labelBox.maxCol = max(labelBox.maxCol, c - 1);
+    }
+}
+
+void StreamColorGrid::recycleLabels(int row) {
+    for (int c = 1; c <= m; c++) {
+        currLabels[c] = find(currLabels[c]);
+        seenRow[currLabels[c]] = row;
+    }
+
+    nextLiveLabels.clear();
+    for (int label : liveLabels) {
+        if (parent[label] == label && seenRow[label] == row) {
+            nextLiveLabels.push_back(label);
+            continue;
+        }
+        if (parent[label] == label)
+            closeComponent(label);
+        freeLabels.push_back(label);
+    }
+    swap(liveLabels, nextLiveLabels);
+}
+
+void StreamColorGrid::closeComponent(int root) {
+    if (size[root] > maxRegionSize ||
+        (size[root] == maxRegionSize && firstCell[root] < maxFirstCell)) {
+        maxRegionSize = size[root];
+        maxFirstCell = firstCell[root];
+        maxColor = color[root];
+        maxBox = box[root];
+    }
+}
+
+void StreamColorGrid::displayMaxRegion() const {
+    ostringstream oss;
+    oss << "Max connected colors (" << algo << "): " << maxRegionSize << ", color " << maxColor << "\n"
+        << "Bounding box - Top Left: (" << maxBox.minRow << ", " << maxBox.minCol << "), "
+        << "Bottom Right: (" << maxBox.maxRow << ", " << maxBox.maxCol << ").\n";
+    formatTxt(oss, LIGHT_CYAN);
+}
+
+#pragma warning(pop)
@@ -17,37 +17,62 @@
  * The original author, Yaron Dayan, must be credited in all derivative works.
  */
 
+#include <thread>
+
 #include "headers/union_find.hpp"
 
-int UnionFind::find(int x) {
-    // path compression 
-    if (parent[x] != x) {
-        parent[x] = find(parent[x]);
-    }
-    return parent[x];
-}
+template <typename FindPolicy, typename UnionPolicy>
+UnionFind<FindPolicy, UnionPolicy>::UnionFind(int n) : parent(n, -1) {}
 
-UnionFind::UnionFind(int n) {
-    parent.resize(n);
-    size.resize(n);
-    for (int i = 0; i < n; ++i) {
-        parent[i] = i;
-        size[i] = 1;
-    }
+template class UnionFind<PathCompression, UnionBySize>;
+template class UnionFind<PathHalving, UnionBySize>;
+template class UnionFind<PathSplitting, UnionBySize>;
+template class UnionFind<PathSplitting, RemUnion>;
+
+ConcurrentUnionFind::ConcurrentUnionFind(int n) : parent(n) {
+    for (int i = 0; i < n; ++i)
+        parent[i].store(i, memory_order_relaxed);
 }
 
-void UnionFind::unite(int x, int y) {
-    int rootX = find(x);
-    int rootY = find(y);
-    if (rootX != rootY) {
-        if (size[rootX] < size[rootY]) {
-            swap(rootX, rootY);
+void ConcurrentUnionFind::finalize(int threads) {
+    const int n = static_cast<int>(parent.size());
+    const int numOfWorkers = max(1, min(threads, n));
+
+    auto runParallel = [&](auto &&task) {
+        vector<thread> workers;
+        for (int w = 1; w < numOfWorkers; w++)
+            workers.emplace_back([&, w] { task(n * static_cast<long long>(w) / numOfWorkers,
+                                               n * static_cast<long long>(w + 1) / numOfWorkers); });
+        task(0, n / numOfWorkers);
+        for (auto &worker : workers)
+            worker.join();
+    };
+
+    // 1) point every cell straight at its root
+    runParallel([&](long long first, long long last) {
+        for (long long x = first; x < last; x++)
+            parent[x].store(find(static_cast<int>(x)), memory_order_relaxed);
+    });
+
+    // 2) roots start out counting themselves
+    runParallel([&](long long first, long long last) {
+        for (long long x = first; x < last; x++) {
+            if (parent[x].load(memory_order_relaxed) == x)
+                parent[x].store(-1, memory_order_relaxed);
+        }
+    });
+
+    // 3) count the members (which now hold their root index) into their roots
+    runParallel([&](long long first, long long last) {
+        for (long long x = first; x < last; x++) {
+            int32_t root = parent[x].load(memory_order_relaxed);
+            if (root >= 0)
+                parent[root].fetch_sub(1, memory_order_relaxed);
         }
-        parent[rootY] = rootX;
-        size[rootX] += size[rootY];
-    }
+    });
 }
 
-int UnionFind::getSize(int x) {
-    return size[find(x)];
+bool isInvalidUfPolicy(const string &policy) {
+    return (policy != "COMPRESS" && policy != "HALVING" && policy != "SPLITTING" &&
+            policy != "REM" && policy != "LOCKFREE");
 }